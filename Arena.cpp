@@ -0,0 +1,179 @@
+// Arena.cpp
+// Purpose: Implement the block-based bump allocator.
+
+#include "Arena.h"
+#include "Instrument.h"
+#include <cstring>
+
+// Implements: void addBlock(size_t minBytes);
+// Private helper: Reuse a spare block or allocate one of at least minBytes (sizes double per block)
+void Arena::addBlock(size_t minBytes) {
+    if (spare && spare->capacity >= minBytes) {
+        Block* block = spare;
+        spare = spare->next;
+        block->next = blocks;
+        blocks = block;
+        cursor = reinterpret_cast<char*>(block) + sizeof(Block);
+        limit = cursor + block->capacity;
+        return;
+    }
+    size_t size = (blocks == nullptr) ? minBlockSize : blocks->capacity * 2;
+    if (size > maxBlockSize) {
+        size = maxBlockSize;
+    }
+    if (size < minBytes) {
+        size = minBytes;
+    }
+    char* raw = new char[sizeof(Block) + size];
+    INDEXER_COUNT(arenaBlocks, 1);
+    Block* block = reinterpret_cast<Block*>(raw);
+    block->next = blocks;
+    block->capacity = size;
+    blocks = block;
+    cursor = raw + sizeof(Block);
+    limit = cursor + size;
+    reserved += size;
+}
+
+// Implements: Arena();
+// Default constructor: No blocks until the first allocation
+Arena::Arena() : blocks(nullptr), spare(nullptr), cursor(nullptr), limit(nullptr), used(0), reserved(0) {}
+
+// Implements: Arena(Arena&& other) noexcept;
+// Move constructor: Transfer blocks, leave other empty
+Arena::Arena(Arena&& other) noexcept
+    : blocks(other.blocks), spare(other.spare), cursor(other.cursor), limit(other.limit),
+      used(other.used), reserved(other.reserved) {
+    other.blocks = other.spare = nullptr;
+    other.cursor = other.limit = nullptr;
+    other.used = other.reserved = 0;
+}
+
+// Implements: ~Arena();
+// Destructor: Release all blocks
+Arena::~Arena() {
+    clear();
+}
+
+// Implements: Arena& operator=(Arena&& other) noexcept;
+// Move assignment: Release own blocks, transfer other's
+Arena& Arena::operator=(Arena&& other) noexcept {
+    if (this != &other) {
+        clear();
+        blocks = other.blocks;
+        spare = other.spare;
+        cursor = other.cursor;
+        limit = other.limit;
+        used = other.used;
+        reserved = other.reserved;
+        other.blocks = other.spare = nullptr;
+        other.cursor = other.limit = nullptr;
+        other.used = other.reserved = 0;
+    }
+    return *this;
+}
+
+// Implements: char* allocate(size_t bytes);
+// allocate: Bump the cursor, starting a new block when the current one is full
+char* Arena::allocate(size_t bytes) {
+    if (static_cast<size_t>(limit - cursor) < bytes || cursor == nullptr) {
+        addBlock(bytes);
+    }
+    char* result = cursor;
+    cursor += bytes;
+    used += bytes;
+    return result;
+}
+
+// Implements: const char* copyString(const char* str, size_t len);
+// copyString: Copy len bytes and a null terminator into the arena
+const char* Arena::copyString(const char* str, size_t len) {
+    char* copy = allocate(len + 1);
+    if (len > 0) {
+        std::memcpy(copy, str, len);
+    }
+    copy[len] = '\0';
+    return copy;
+}
+
+// Implements: void adopt(Arena& other);
+// adopt: Splice other's blocks behind the current block; other is left empty
+void Arena::adopt(Arena& other) {
+    if (this == &other) {
+        return;
+    }
+    if (blocks == nullptr) {
+        // Nothing in use here: continue bumping in other's current block
+        blocks = other.blocks;
+        cursor = other.cursor;
+        limit = other.limit;
+    } else if (other.blocks) {
+        Block* last = other.blocks;
+        while (last->next) {
+            last = last->next;
+        }
+        last->next = blocks->next;
+        blocks->next = other.blocks;
+    }
+    while (other.spare) {
+        Block* next = other.spare->next;
+        other.spare->next = spare;
+        spare = other.spare;
+        other.spare = next;
+    }
+    used += other.used;
+    reserved += other.reserved;
+    other.blocks = nullptr;
+    other.cursor = other.limit = nullptr;
+    other.used = other.reserved = 0;
+}
+
+// Implements: void reset();
+// reset: Move every block to the spare list without freeing anything
+void Arena::reset() {
+    while (blocks) {
+        Block* next = blocks->next;
+        blocks->next = spare;
+        spare = blocks;
+        blocks = next;
+    }
+    cursor = limit = nullptr;
+    used = 0;
+}
+
+// Implements: void clear();
+// clear: Release every block, in use or spare
+void Arena::clear() {
+    reset();
+    while (spare) {
+        Block* next = spare->next;
+        delete[] reinterpret_cast<char*>(spare);
+        spare = next;
+    }
+    cursor = limit = nullptr;
+    used = 0;
+    reserved = 0;
+}
+
+// Implements: void releaseSpare();
+// releaseSpare: Free the blocks reset() kept; blocks in use stay
+void Arena::releaseSpare() {
+    while (spare) {
+        Block* next = spare->next;
+        reserved -= spare->capacity;
+        delete[] reinterpret_cast<char*>(spare);
+        spare = next;
+    }
+}
+
+// Implements: size_t bytesUsed() const;
+// bytesUsed: Bytes handed out
+size_t Arena::bytesUsed() const {
+    return used;
+}
+
+// Implements: size_t bytesReserved() const;
+// bytesReserved: Bytes held in blocks
+size_t Arena::bytesReserved() const {
+    return reserved;
+}
@@ -0,0 +1,56 @@
+// Arena.h
+// Purpose: Declare the Arena class, a bump allocator for token bytes. Memory is
+// carved from large blocks and only released all at once, so interning a token
+// costs a pointer bump and clearing an index frees a handful of blocks instead
+// of one allocation per token. reset() keeps the blocks so that re-indexing reuses
+// memory that is already mapped.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+
+class Arena {
+private:
+    // Blocks form a singly linked list, newest first; bytes follow the header
+    struct Block {
+        Block* next;        // Previously filled block
+        size_t capacity;    // Usable bytes after the header
+    };
+
+    static const size_t minBlockSize = 64 * 1024;   // First block size (doubles up to maxBlockSize)
+    static const size_t maxBlockSize = 4 * 1024 * 1024;
+
+    Block* blocks;          // Current block (head of list)
+    Block* spare;           // Blocks kept by reset() for reuse
+    char* cursor;           // Next free byte in the current block
+    char* limit;            // End of the current block
+    size_t used;            // Bytes handed out
+    size_t reserved;        // Bytes held in blocks
+    void addBlock(size_t minBytes); // Private helper: start a new block
+
+public:
+    // Constructors
+    Arena();                                // Default constructor: No blocks
+    Arena(const Arena& other) = delete;     // Copy constructor: Deleted
+    Arena(Arena&& other) noexcept;          // Move constructor: Transfer blocks
+
+    // Destructor
+    ~Arena();
+
+    // Assignment operators
+    Arena& operator=(const Arena& other) = delete;  // Copy assignment: Deleted
+    Arena& operator=(Arena&& other) noexcept;       // Move assignment: Transfer blocks
+
+    // Public methods
+    char* allocate(size_t bytes);           // Return bytes of storage (1-byte alignment)
+    const char* copyString(const char* str, size_t len); // Copy a view plus null terminator
+    void adopt(Arena& other);               // Take ownership of other's blocks (pointers stay valid)
+    void reset();                           // Rewind, keeping blocks for reuse
+    void clear();                           // Release all blocks
+    void releaseSpare();                    // Release the blocks kept by reset()
+    size_t bytesUsed() const;               // Bytes handed out
+    size_t bytesReserved() const;           // Bytes held in blocks
+};
+
+#endif // ARENA_H
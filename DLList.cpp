@@ -4,14 +4,22 @@
 // 1. Include header file
 //    - Include DLList.h to access the class declaration.
 
-// 2. Implement private helper function
-//    - getNodeAt: Return node at pos, throw std::out_of_range if invalid.
+// 2. Implement private helper functions
+//    - getNodeAt: Return node at pos via nodeIndex (or seek while it is stale), throw std::out_of_range if invalid.
+//    - seek: Walk from the nearest of head, tail and finger; rebuild nodeIndex instead once the
+//      walks since it went stale add up to its length.
+//    - unlinkNode: Detach a node from its neighbours and head/tail.
+//    - newNode (in DLList.h) / deleteNode: Placement-construct in / destroy and return to the NodePool.
+//    - linkBefore: Link a constructed node before another node (or at the tail).
+//    - ensureIndex: Rebuild nodeIndex by walking the links when iterator edits left it stale.
+//    - NodePool: Carve slots from blocks (32 nodes, doubling to 4096), reuse released slots first,
+//      and on rewind start again from the oldest block.
 
 // 3. Implement default constructor
 //    - Initialize empty list: head = nullptr, tail = nullptr, nodeCount = 0.
 
 // 4. Implement copy constructor
-//    - Deep copy other’s list, node by node.
+//    - Deep copy other’s list, node by node; copied tokens own their text, even arena views.
 
 // 5. Implement move constructor
 //    - Transfer head, tail, nodeCount; set other to empty (noexcept).
@@ -26,10 +34,12 @@
 //    - Check self-assignment, clear current list, transfer other’s data (noexcept).
 
 // 9. Implement addBefore
-//    - Insert new node before pos, update links, throw std::out_of_range.
+//    - Copy or move data into a new node before pos via emplaceBefore (in DLList.h), throw std::out_of_range.
+//    - emplaceBefore builds the IndexedToken inside the node, so inserting costs no temporary copy.
 
 // 10. Implement remove
 //     - Remove node at pos, update links, return true, throw std::out_of_range.
+//     - With a stale nodeIndex, the successor of the removed node becomes the finger.
 
 // 11. Implement getIndexedTokenAt (non-const)
 //     - Return IndexedToken& at pos, throw std::out_of_range.
@@ -49,10 +59,169 @@
 //     - Mark as const.
 
 // 16. Implement print
-//     - Output each IndexedToken to ostream.
+//     - Output each IndexedToken to ostream (or OutputBuffer), newline-separated.
+//     - Walk nodeIndex, prefetching the node a few entries ahead and the token text of the next
+//       one, so the loads overlap instead of waiting on each next pointer in turn.
 //     - Mark as const.
 
+// 17. Implement lowerBound
+//     - Binary search over nodeIndex for the first token not less than text.
+//     - Mark as const.
+
+// 18. Implement sort
+//     - Sort nodeIndex by token text, then relink prev/next/head/tail to match.
+
+// 19. Implement bytesUsed, bytesReserved and shrinkToFit
+//     - Slots on the free list and blocks kept by rewind count as reserved, not used.
+//     - shrinkToFit frees only the blocks past the one being carved (released slots in earlier
+//       blocks stay for reuse) and drops a stale nodeIndex instead of trimming it.
+
 #include "DLList.h"
+#include <algorithm>
+
+namespace {
+
+// Entries ahead of the one being printed whose node is prefetched
+const size_t prefetchDistance = 8;
+
+// Hint that p will be read soon
+inline void prefetch(const void* p) {
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+} // namespace
+
+// Implements: NodePool();
+// NodePool default constructor: No blocks yet
+DLList::NodePool::NodePool() : first(nullptr), last(nullptr), current(nullptr), used(0), freeList(nullptr) {}
+
+// Implements: NodePool(NodePool&& other) noexcept;
+// NodePool move constructor: Transfer the blocks
+DLList::NodePool::NodePool(NodePool&& other) noexcept
+    : first(other.first), last(other.last), current(other.current), used(other.used),
+      freeList(other.freeList) {
+    other.first = other.last = other.current = nullptr;
+    other.used = 0;
+    other.freeList = nullptr;
+}
+
+// Implements: NodePool& operator=(NodePool&& other) noexcept;
+// NodePool move assignment: Free own blocks (nodes already destroyed), transfer other's
+DLList::NodePool& DLList::NodePool::operator=(NodePool&& other) noexcept {
+    if (this != &other) {
+        freeBlocks();
+        first = other.first;
+        last = other.last;
+        current = other.current;
+        used = other.used;
+        freeList = other.freeList;
+        other.first = other.last = other.current = nullptr;
+        other.used = 0;
+        other.freeList = nullptr;
+    }
+    return *this;
+}
+
+// Implements: ~NodePool();
+// NodePool destructor: Free every block
+DLList::NodePool::~NodePool() {
+    freeBlocks();
+}
+
+// Implements: void freeBlocks();
+// NodePool private helper: Release all blocks
+void DLList::NodePool::freeBlocks() {
+    while (first) {
+        Block* next = first->next;
+        ::operator delete(first);
+        first = next;
+    }
+    last = current = nullptr;
+}
+
+// Implements: static Node* slot(Block* block, size_t i);
+// NodePool private helper: Slots follow the block header
+DLList::Node* DLList::NodePool::slot(Block* block, size_t i) {
+    return reinterpret_cast<Node*>(reinterpret_cast<char*>(block) + headerBytes) + i;
+}
+
+// Implements: void* allocate();
+// allocate: Released slot, else the next slot of the current block, else the next kept or a new block
+void* DLList::NodePool::allocate() {
+    if (freeList) {
+        void* p = freeList;
+        freeList = *static_cast<void**>(p);
+        return p;
+    }
+    if (!current || used == current->slots) {
+        Block* next = current ? current->next : first;
+        if (!next) {
+            size_t slots = !last ? firstBlockNodes
+                         : (last->slots * 2 < maxBlockNodes) ? last->slots * 2 : maxBlockNodes;
+            next = static_cast<Block*>(::operator new(headerBytes + slots * sizeof(Node)));
+            next->next = nullptr;
+            next->slots = slots;
+            (last ? last->next : first) = next;
+            last = next;
+        }
+        current = next;
+        used = 0;
+    }
+    return slot(current, used++);
+}
+
+// Implements: void release(void* p);
+// release: Push the slot on the free list
+void DLList::NodePool::release(void* p) {
+    *static_cast<void**>(p) = freeList;
+    freeList = p;
+}
+
+// Implements: void rewind();
+// rewind: All slots are free again; allocation restarts at the oldest block
+void DLList::NodePool::rewind() {
+    current = nullptr;
+    used = 0;
+    freeList = nullptr;
+}
+
+// Implements: void trim();
+// trim: Free the blocks after current (all of them before the first allocation)
+void DLList::NodePool::trim() {
+    Block* block = current ? current->next : first;
+    while (block) {
+        Block* next = block->next;
+        ::operator delete(block);
+        block = next;
+    }
+    if (current) {
+        current->next = nullptr;
+        last = current;
+    } else {
+        first = last = nullptr;
+    }
+}
+
+// Implements: size_t bytesReserved() const;
+// bytesReserved: Header and slots of every block
+size_t DLList::NodePool::bytesReserved() const {
+    size_t bytes = 0;
+    for (Block* block = first; block; block = block->next) {
+        bytes += headerBytes + block->slots * sizeof(Node);
+    }
+    return bytes;
+}
+
+// Implements: void deleteNode(Node* node);
+// Helper: Destroy a node and recycle its slot
+void DLList::deleteNode(Node* node) {
+    node->~Node();
+    pool.release(node);
+}
 
 // Implements: Node* getNodeAt(size_t pos) const;
 // Helper: Return node at pos, throw if invalid
@@ -60,20 +229,92 @@ DLList::Node* DLList::getNodeAt(size_t pos) const {
     if (pos >= nodeCount) {
         throw std::out_of_range("Position out of range");
     }
+    return indexValid ? nodeIndex[pos] : seek(pos);
+}
+
+// Implements: Node* seek(size_t pos) const;
+// Helper: Walk to pos from whichever of head, tail and finger is nearest (pos < nodeCount).
+// Walks are charged to staleSteps; once they add up to a full rebuild, rebuild instead, so
+// near-sequential access costs O(1) per call and scattered access stays amortized O(1)
+DLList::Node* DLList::seek(size_t pos) const {
     Node* current = head;
-    for (size_t i = 0; i < pos; ++i) {
+    size_t at = 0;
+    size_t distance = pos;
+    if (nodeCount - 1 - pos < distance) {
+        current = tail;
+        at = nodeCount - 1;
+        distance = nodeCount - 1 - pos;
+    }
+    if (finger) {
+        size_t fromFinger = pos > fingerPos ? pos - fingerPos : fingerPos - pos;
+        if (fromFinger < distance) {
+            current = finger;
+            at = fingerPos;
+            distance = fromFinger;
+        }
+    }
+    if (staleSteps + distance > nodeCount) {
+        ensureIndex();
+        return nodeIndex[pos];
+    }
+    staleSteps += distance;
+    INDEXER_COUNT(listNodeHops, distance);
+    for (; at < pos; ++at) {
         current = current->next;
     }
+    for (; at > pos; --at) {
+        current = current->prev;
+    }
+    finger = current;
+    fingerPos = pos;
     return current;
 }
 
+// Implements: void ensureIndex() const;
+// Helper: Rebuild nodeIndex from the links after iterator edits made it stale
+void DLList::ensureIndex() const {
+    if (indexValid) {
+        return;
+    }
+    INDEXER_COUNT(listIndexRebuilds, 1);
+    nodeIndex.clear();
+    nodeIndex.reserve(nodeCount);
+    for (Node* current = head; current; current = current->next) {
+        nodeIndex.push_back(current);
+    }
+    indexValid = true;
+    finger = nullptr;
+    staleSteps = 0;
+}
+
+// Implements: void unlinkNode(Node* node);
+// Helper: Unlink a node from its neighbours and head/tail; nodeIndex is the caller's business
+void DLList::unlinkNode(Node* node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        tail = node->prev;
+    }
+    --nodeCount;
+}
+
 // Implements: DLList();
 // Default constructor: Empty list
-DLList::DLList() : head(nullptr), tail(nullptr), nodeCount(0) {}
+DLList::DLList()
+    : head(nullptr), tail(nullptr), nodeCount(0), indexValid(true), finger(nullptr), fingerPos(0),
+      staleSteps(0) {}
 
 // Implements: DLList(const DLList& other);
 // Copy constructor: Deep copy
-DLList::DLList(const DLList& other) : head(nullptr), tail(nullptr), nodeCount(0) {
+DLList::DLList(const DLList& other)
+    : head(nullptr), tail(nullptr), nodeCount(0), indexValid(true), finger(nullptr), fingerPos(0),
+      staleSteps(0) {
+    nodeIndex.reserve(other.nodeCount);
     Node* current = other.head;
     while (current) {
         addBefore(current->data, nodeCount); // Appends to end
@@ -84,7 +325,13 @@ DLList::DLList(const DLList& other) : head(nullptr), tail(nullptr), nodeCount(0)
 // Implements: DLList(DLList&& other) noexcept;
 // Move constructor: Transfer ownership
 DLList::DLList(DLList&& other) noexcept
-    : head(other.head), tail(other.tail), nodeCount(other.nodeCount) {
+    : pool(std::move(other.pool)), head(other.head), tail(other.tail), nodeCount(other.nodeCount),
+      nodeIndex(std::move(other.nodeIndex)), indexValid(other.indexValid), finger(other.finger),
+      fingerPos(other.fingerPos), staleSteps(other.staleSteps) {
+    other.nodeIndex.clear();
+    other.indexValid = true;
+    other.finger = nullptr;
+    other.staleSteps = 0;
     other.head = nullptr;
     other.tail = nullptr;
     other.nodeCount = 0;
@@ -101,6 +348,7 @@ DLList::~DLList() {
 DLList& DLList::operator=(const DLList& other) {
     if (this != &other) {
         clear();
+        nodeIndex.reserve(other.nodeCount);
         Node* current = other.head;
         while (current) {
             addBefore(current->data, nodeCount); // Appends to end
@@ -115,9 +363,19 @@ DLList& DLList::operator=(const DLList& other) {
 DLList& DLList::operator=(DLList&& other) noexcept {
     if (this != &other) {
         clear();
+        pool = std::move(other.pool);
         head = other.head;
         tail = other.tail;
         nodeCount = other.nodeCount;
+        nodeIndex = std::move(other.nodeIndex);
+        indexValid = other.indexValid;
+        finger = other.finger;
+        fingerPos = other.fingerPos;
+        staleSteps = other.staleSteps;
+        other.nodeIndex.clear();
+        other.indexValid = true;
+        other.finger = nullptr;
+        other.staleSteps = 0;
         other.head = nullptr;
         other.tail = nullptr;
         other.nodeCount = 0;
@@ -125,33 +383,41 @@ DLList& DLList::operator=(DLList&& other) noexcept {
     return *this;
 }
 
-// Implements: void addBefore(IndexedToken data, size_t pos);
-// addBefore: Insert before pos, throw if invalid
-void DLList::addBefore(IndexedToken data, size_t pos) {
-    if (pos > nodeCount) {
-        throw std::out_of_range("Position out of range");
-    }
-    Node* newNode = new Node(data);
-    if (nodeCount == 0) {
-        // Empty list
-        head = tail = newNode;
-    } else if (pos == 0) {
-        // Insert at head
-        newNode->next = head;
-        head->prev = newNode;
-        head = newNode;
-    } else if (pos == nodeCount) {
-        // Insert at tail
-        newNode->prev = tail;
-        tail->next = newNode;
-        tail = newNode;
+// Implements: void addBefore(const IndexedToken& data, size_t pos);
+// addBefore: Insert a copy before pos, throw if invalid
+void DLList::addBefore(const IndexedToken& data, size_t pos) {
+    emplaceBefore(pos, data);
+}
+
+// Implements: void addBefore(IndexedToken&& data, size_t pos);
+// addBefore: Move data into a new node before pos, throw if invalid
+void DLList::addBefore(IndexedToken&& data, size_t pos) {
+    emplaceBefore(pos, std::move(data));
+}
+
+// Implements: void linkBefore(Node* added, Node* before);
+// Helper: Link a constructed node before another node (nullptr: after the tail); nodeIndex is
+// the caller's business
+void DLList::linkBefore(Node* added, Node* before) {
+    if (!before) {
+        // Insert at tail (or into an empty list)
+        added->prev = tail;
+        if (tail) {
+            tail->next = added;
+        } else {
+            head = added;
+        }
+        tail = added;
     } else {
-        // Insert in middle
-        Node* current = getNodeAt(pos);
-        newNode->prev = current->prev;
-        newNode->next = current;
-        current->prev->next = newNode;
-        current->prev = newNode;
+        // Insert at head or in middle
+        added->prev = before->prev;
+        added->next = before;
+        if (before->prev) {
+            before->prev->next = added;
+        } else {
+            head = added;
+        }
+        before->prev = added;
     }
     ++nodeCount;
 }
@@ -163,24 +429,15 @@ bool DLList::remove(size_t pos) {
         throw std::out_of_range("Position out of range");
     }
     Node* current = getNodeAt(pos);
-    if (nodeCount == 1) {
-        // Single node
-        head = tail = nullptr;
-    } else if (current == head) {
-        // Remove head
-        head = head->next;
-        head->prev = nullptr;
-    } else if (current == tail) {
-        // Remove tail
-        tail = tail->prev;
-        tail->next = nullptr;
+    if (indexValid) {
+        nodeIndex.erase(nodeIndex.begin() + pos);
+        INDEXER_COUNT(listIndexShifts, nodeCount - 1 - pos);
     } else {
-        // Remove in middle
-        current->prev->next = current->next;
-        current->next->prev = current->prev;
+        // seek left the finger on current; its successor takes over the position
+        finger = current->next;
     }
-    delete current;
-    --nodeCount;
+    unlinkNode(current);
+    deleteNode(current);
     return true;
 }
 
@@ -199,14 +456,18 @@ const IndexedToken& DLList::getIndexedTokenAt(size_t pos) const {
 // Implements: void clear();
 // clear: Remove all nodes
 void DLList::clear() {
-    Node* current = head;
-    while (current) {
+    for (Node* current = head; current; ) {
         Node* next = current->next;
-        delete current;
+        current->~Node();
         current = next;
     }
+    pool.rewind();
     head = tail = nullptr;
     nodeCount = 0;
+    nodeIndex.clear();
+    indexValid = true;
+    finger = nullptr;
+    staleSteps = 0;
 }
 
 // Implements: size_t size() const;
@@ -224,12 +485,268 @@ bool DLList::isEmpty() const {
 // Implements: void print(std::ostream& os) const;
 // print: Output all IndexedTokens
 void DLList::print(std::ostream& os) const {
-    Node* current = head;
-    while (current) {
-        current->data.print(os);
-        if (current->next) {
+    ensureIndex();
+    for (size_t i = 0; i < nodeCount; ++i) {
+        if (i + prefetchDistance < nodeCount) {
+            prefetch(nodeIndex[i + prefetchDistance]);
+        }
+        if (i > 0) {
             os << "\n";
         }
-        current = current->next;
+        nodeIndex[i]->data.print(os);
     }
-}
\ No newline at end of file
+}
+
+// Implements: void print(OutputBuffer& out) const;
+// print: Append all IndexedTokens
+void DLList::print(OutputBuffer& out) const {
+    ensureIndex();
+    for (size_t i = 0; i < nodeCount; ++i) {
+        if (i + prefetchDistance < nodeCount) {
+            prefetch(nodeIndex[i + prefetchDistance]);
+        }
+        if (i + 1 < nodeCount) {
+            prefetch(nodeIndex[i + 1]->data.getToken().c_str());
+        }
+        if (i > 0) {
+            out.append('\n');
+        }
+        nodeIndex[i]->data.print(out);
+    }
+}
+
+// Implements: size_t lowerBound(const char* text, size_t length) const;
+// lowerBound: Binary search for first position whose token is not less than the view
+size_t DLList::lowerBound(const char* text, size_t length) const {
+    ensureIndex();
+    size_t lo = 0;
+    size_t hi = nodeCount;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (nodeIndex[mid]->data.compare(text, length) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Implements: void sort();
+// sort: Order nodeIndex by token text, then relink nodes to match
+void DLList::sort() {
+    if (nodeCount < 2) {
+        return;
+    }
+    INDEXER_COUNT(listSorts, 1);
+    ensureIndex();
+    std::sort(nodeIndex.begin(), nodeIndex.end(), [](const Node* a, const Node* b) {
+        return a->data.compare(b->data) < 0;
+    });
+    for (size_t i = 0; i < nodeCount; ++i) {
+        nodeIndex[i]->prev = (i > 0) ? nodeIndex[i - 1] : nullptr;
+        nodeIndex[i]->next = (i + 1 < nodeCount) ? nodeIndex[i + 1] : nullptr;
+    }
+    head = nodeIndex.front();
+    tail = nodeIndex.back();
+}
+
+// Implements: size_t bytesUsed() const;
+// bytesUsed: Live nodes (token and posting fields included) plus nodeIndex entries
+size_t DLList::bytesUsed() const {
+    return nodeCount * sizeof(Node) + nodeIndex.size() * sizeof(Node*);
+}
+
+// Implements: size_t bytesReserved() const;
+// bytesReserved: Pool blocks plus nodeIndex capacity
+size_t DLList::bytesReserved() const {
+    return pool.bytesReserved() + nodeIndex.capacity() * sizeof(Node*);
+}
+
+// Implements: void shrinkToFit();
+// shrinkToFit: Free unused pool blocks; trim nodeIndex, or release it while stale (rebuilt on demand)
+void DLList::shrinkToFit() {
+    pool.trim();
+    if (!indexValid) {
+        nodeIndex.clear();
+    }
+    nodeIndex.shrink_to_fit();
+}
+
+// Implements: iterator begin();
+// begin: Iterator at the head
+DLList::iterator DLList::begin() {
+    return iterator(head, this);
+}
+
+// Implements: iterator end();
+// end: Iterator past the tail
+DLList::iterator DLList::end() {
+    return iterator(nullptr, this);
+}
+
+// Implements: const_iterator begin() const;
+// begin: Read-only iterator at the head
+DLList::const_iterator DLList::begin() const {
+    return const_iterator(head, this);
+}
+
+// Implements: const_iterator end() const;
+// end: Read-only iterator past the tail
+DLList::const_iterator DLList::end() const {
+    return const_iterator(nullptr, this);
+}
+
+// Implements: iterator erase(const_iterator it);
+// erase: Unlink and destroy the node at it, throw if it is end(); removing the tail keeps
+// nodeIndex current, removing elsewhere leaves it to be rebuilt by the next positional call
+DLList::iterator DLList::erase(const_iterator it) {
+    Node* current = const_cast<Node*>(it.node);
+    if (!current) {
+        throw std::out_of_range("Cannot erase end()");
+    }
+    Node* next = current->next;
+    if (current == tail && indexValid) {
+        nodeIndex.pop_back();
+    } else {
+        indexValid = false;
+        if (current == finger) {
+            finger = next;      // Takes over the position (nullptr at the tail)
+        } else if (current == head) {
+            --fingerPos;        // Every position shifts by one
+        } else if (current != tail) {
+            finger = nullptr;   // Position of the erased node is unknown
+        }
+    }
+    unlinkNode(current);
+    deleteNode(current);
+    return iterator(next, this);
+}
+
+// Implements: iterator(Node* node, const DLList* list);
+// iterator: Position at node of list
+DLList::iterator::iterator(Node* node, const DLList* list) : node(node), list(list) {}
+
+// Implements: iterator();
+// iterator: Singular iterator, only assignable
+DLList::iterator::iterator() : node(nullptr), list(nullptr) {}
+
+// Implements: IndexedToken& operator*() const;
+// operator*: Current entry
+IndexedToken& DLList::iterator::operator*() const {
+    return node->data;
+}
+
+// Implements: IndexedToken* operator->() const;
+// operator->: Current entry
+IndexedToken* DLList::iterator::operator->() const {
+    return &node->data;
+}
+
+// Implements: iterator& operator++();
+// operator++: Follow the next link
+DLList::iterator& DLList::iterator::operator++() {
+    node = node->next;
+    return *this;
+}
+
+// Implements: iterator operator++(int);
+// operator++: Follow the next link, return the previous position
+DLList::iterator DLList::iterator::operator++(int) {
+    iterator before = *this;
+    node = node->next;
+    return before;
+}
+
+// Implements: iterator& operator--();
+// operator--: Follow the prev link, or step from end() to the tail
+DLList::iterator& DLList::iterator::operator--() {
+    node = node ? node->prev : list->tail;
+    return *this;
+}
+
+// Implements: iterator operator--(int);
+// operator--: Step back, return the previous position
+DLList::iterator DLList::iterator::operator--(int) {
+    iterator before = *this;
+    --*this;
+    return before;
+}
+
+// Implements: bool operator==(const iterator& other) const;
+// operator==: Same node
+bool DLList::iterator::operator==(const iterator& other) const {
+    return node == other.node;
+}
+
+// Implements: bool operator!=(const iterator& other) const;
+// operator!=: Different node
+bool DLList::iterator::operator!=(const iterator& other) const {
+    return node != other.node;
+}
+
+// Implements: const_iterator(const Node* node, const DLList* list);
+// const_iterator: Position at node of list
+DLList::const_iterator::const_iterator(const Node* node, const DLList* list) : node(node), list(list) {}
+
+// Implements: const_iterator();
+// const_iterator: Singular iterator, only assignable
+DLList::const_iterator::const_iterator() : node(nullptr), list(nullptr) {}
+
+// Implements: const_iterator(const iterator& other);
+// const_iterator: Same position as a mutable iterator
+DLList::const_iterator::const_iterator(const iterator& other) : node(other.node), list(other.list) {}
+
+// Implements: const IndexedToken& operator*() const;
+// operator*: Current entry
+const IndexedToken& DLList::const_iterator::operator*() const {
+    return node->data;
+}
+
+// Implements: const IndexedToken* operator->() const;
+// operator->: Current entry
+const IndexedToken* DLList::const_iterator::operator->() const {
+    return &node->data;
+}
+
+// Implements: const_iterator& operator++();
+// operator++: Follow the next link
+DLList::const_iterator& DLList::const_iterator::operator++() {
+    node = node->next;
+    return *this;
+}
+
+// Implements: const_iterator operator++(int);
+// operator++: Follow the next link, return the previous position
+DLList::const_iterator DLList::const_iterator::operator++(int) {
+    const_iterator before = *this;
+    node = node->next;
+    return before;
+}
+
+// Implements: const_iterator& operator--();
+// operator--: Follow the prev link, or step from end() to the tail
+DLList::const_iterator& DLList::const_iterator::operator--() {
+    node = node ? node->prev : list->tail;
+    return *this;
+}
+
+// Implements: const_iterator operator--(int);
+// operator--: Step back, return the previous position
+DLList::const_iterator DLList::const_iterator::operator--(int) {
+    const_iterator before = *this;
+    --*this;
+    return before;
+}
+
+// Implements: bool operator==(const const_iterator& other) const;
+// operator==: Same node
+bool DLList::const_iterator::operator==(const const_iterator& other) const {
+    return node == other.node;
+}
+
+// Implements: bool operator!=(const const_iterator& other) const;
+// operator!=: Different node
+bool DLList::const_iterator::operator!=(const const_iterator& other) const {
+    return node != other.node;
+}
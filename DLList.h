@@ -8,15 +8,29 @@
 //    - Include IndexedToken.h for IndexedToken data.
 //    - Include <ostream> for print method.
 //    - Include <stdexcept> for std::out_of_range.
+//    - Include <new> and <utility> for placement new and std::forward in emplaceBefore.
+//    - Include <iterator> for std::bidirectional_iterator_tag.
+//    - Include Instrument.h for the INDEXER_COUNT hooks in the inline templates.
 
 // 3. Declare DLList class
 //    - Define private nested Node class: prev (Node*), data (IndexedToken), next (Node*).
 //    - Define private members: head (Node*), tail (Node*), nodeCount (size_t).
-//    - Declare private helper: getNodeAt.
+//    - Define private member nodeIndex (std::vector<Node*>) mirroring list order for O(1) positional access;
+//      insert_before / erase away from the tail only mark it stale (indexValid), so iterator-based
+//      edits cost O(1).
+//    - Define private members finger / fingerPos (last node reached by position) and staleSteps: while
+//      nodeIndex is stale, positional access walks from the nearest of head, tail and finger, and
+//      rebuilds the index only once the walks have cost as much as a rebuild.
+//    - Define private nested NodePool: nodes are carved from contiguous slabs (not one new per
+//      node) and recycled through a free list, so a section's entries sit densely together.
+//    - Declare private helpers: getNodeAt, seek, ensureIndex, unlinkNode, newNode (constructs the IndexedToken in place
+//      from its constructor arguments), deleteNode, linkBefore.
+//    - Declare nested iterator and const_iterator (bidirectional, STL-conforming) over the nodes.
 
 // 4. Declare constructors
 //    - Default constructor: Initialize empty list.
-//    - Copy constructor: Deep copy.
+//    - Copy constructor: Deep copy (entries take their own token bytes, so the copy outlives the
+//      source's arena).
 //    - Move constructor: Transfer ownership (noexcept).
 
 // 5. Declare destructor
@@ -27,14 +41,24 @@
 //    - Move assignment: Transfer ownership, handle self-assignment (noexcept).
 
 // 7. Declare public methods
-//    - addBefore: Insert IndexedToken before pos, throw std::out_of_range.
+//    - addBefore: Insert IndexedToken before pos (copied, or moved from an rvalue), throw std::out_of_range.
+//    - emplaceBefore: Construct an IndexedToken before pos from constructor arguments (no temporary),
+//      return it, throw std::out_of_range.
 //    - remove: Remove node at pos, throw std::out_of_range.
 //    - getIndexedTokenAt (non-const): Return IndexedToken& at pos, throw std::out_of_range.
 //    - getIndexedTokenAt (const): Return const IndexedToken& at pos, throw std::out_of_range.
 //    - clear: Remove all nodes.
 //    - size (const): Return nodeCount.
 //    - isEmpty (const): Check if list is empty.
-//    - print (const): Output all IndexedToken objects to ostream.
+//    - print (const): Output all IndexedToken objects to ostream, or to an OutputBuffer (fast path);
+//      walks nodeIndex (prefetching ahead) rather than chasing next pointers.
+//    - lowerBound (const): Binary search a sorted list for the first position not less than a token view.
+//    - sort: Order nodes by token text, relinking them without copying data.
+//    - bytesUsed / bytesReserved (const): Live node bytes vs. bytes held by the pool and nodeIndex.
+//    - shrinkToFit: Free pool blocks no node lives in and trim nodeIndex to its length.
+//    - begin / end (const and non-const): Iterators for sweeps and range-for.
+//    - insert_before: Construct an IndexedToken before an iterator, return an iterator to it.
+//    - erase: Remove the node at an iterator, return an iterator to the next one, throw std::out_of_range at end.
 
 // 8. Close include guard
 
@@ -42,8 +66,14 @@
 #define DLLIST_H
 
 #include "IndexedToken.h"
+#include "Instrument.h"
+#include <cstddef>
+#include <iterator>
+#include <new>
 #include <ostream>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 class DLList {
 private:
@@ -53,14 +83,121 @@ private:
         Node* prev;             // Pointer to previous node
         IndexedToken data;      // IndexedToken data
         Node* next;             // Pointer to next node
-        Node(const IndexedToken& data, Node* prv = nullptr, Node* nxt = nullptr)
-            : prev(prv), data(data), next(nxt) {}
+        template <typename... Args>
+        explicit Node(Args&&... args)   // Construct data from IndexedToken constructor arguments
+            : prev(nullptr), data(std::forward<Args>(args)...), next(nullptr) {}
+        Node(const Node& other) = delete;
+        Node& operator=(const Node& other) = delete;
     };
 
+    // Slab allocator for nodes: blocks of contiguous node slots, handed out in order and
+    // recycled through a free list; rewind() keeps the blocks for the next fill
+    class NodePool {
+    private:
+        struct Block {
+            Block* next;        // Next (newer) block
+            size_t slots;       // Node slots after the header
+        };
+        static const size_t firstBlockNodes = 32;   // Doubles per block up to maxBlockNodes
+        static const size_t maxBlockNodes = 4096;
+        static const size_t headerBytes = (sizeof(Block) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+        Block* first;           // Oldest block
+        Block* last;            // Newest block
+        Block* current;         // Block being carved (nullptr before the first allocation)
+        size_t used;            // Slots handed out from current
+        void* freeList;         // Released slots, linked through their first word
+        static Node* slot(Block* block, size_t i); // Private helper: address of slot i
+        void freeBlocks();      // Private helper: release all blocks
+
+    public:
+        NodePool();
+        NodePool(const NodePool& other) = delete;
+        NodePool& operator=(const NodePool& other) = delete;
+        NodePool(NodePool&& other) noexcept;
+        NodePool& operator=(NodePool&& other) noexcept;
+        ~NodePool();
+        void* allocate();           // Storage for one Node
+        void release(void* p);      // Return storage of a destroyed Node
+        void rewind();              // Forget all slots (nodes must be destroyed), keep the blocks
+        void trim();                // Free the blocks past the one being carved
+        size_t bytesReserved() const; // Bytes held in blocks
+    };
+
+    NodePool pool;              // Storage for the nodes
     Node* head;                 // Pointer to first node
     Node* tail;                 // Pointer to last node
     size_t nodeCount;           // Number of nodes
+    // Positional access rebuilds a stale index, so const methods may refresh it
+    mutable std::vector<Node*> nodeIndex; // Nodes in list order, for O(1) positional access
+    mutable bool indexValid;    // False after an iterator edit away from the tail
+    mutable Node* finger;       // Last node reached by seek (nullptr if none or unknown position)
+    mutable size_t fingerPos;   // Position of finger
+    mutable size_t staleSteps;  // Links walked by seek since nodeIndex went stale
     Node* getNodeAt(size_t pos) const; // Helper to get node at position
+    Node* seek(size_t pos) const; // Helper to walk to pos from the nearest known node (index stale)
+    void ensureIndex() const;   // Helper to rebuild nodeIndex if stale
+    void unlinkNode(Node* node); // Helper to unlink a node (nodeIndex is the caller's business)
+    template <typename... Args>
+    Node* newNode(Args&&... args);      // Helper to construct a node in the pool
+    void deleteNode(Node* node);        // Helper to destroy a node and recycle its slot
+    void linkBefore(Node* added, Node* before); // Helper to link a new node before another (nullptr: at tail)
+
+public:
+    class const_iterator;
+
+    // Bidirectional iterator over the entries; stays valid until its node is erased
+    class iterator {
+    private:
+        Node* node;             // Current node (nullptr at end)
+        const DLList* list;     // Owning list, so that --end() reaches the tail
+        iterator(Node* node, const DLList* list);
+        friend class DLList;
+        friend class const_iterator;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef IndexedToken value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef IndexedToken* pointer;
+        typedef IndexedToken& reference;
+
+        iterator();                                 // Singular iterator
+        IndexedToken& operator*() const;            // Current entry
+        IndexedToken* operator->() const;
+        iterator& operator++();                     // Next entry
+        iterator operator++(int);
+        iterator& operator--();                     // Previous entry (the tail from end())
+        iterator operator--(int);
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const;
+    };
+
+    // Read-only counterpart of iterator; converts from iterator
+    class const_iterator {
+    private:
+        const Node* node;       // Current node (nullptr at end)
+        const DLList* list;     // Owning list, so that --end() reaches the tail
+        const_iterator(const Node* node, const DLList* list);
+        friend class DLList;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef IndexedToken value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const IndexedToken* pointer;
+        typedef const IndexedToken& reference;
+
+        const_iterator();                           // Singular iterator
+        const_iterator(const iterator& other);      // Conversion from iterator
+        const IndexedToken& operator*() const;      // Current entry
+        const IndexedToken* operator->() const;
+        const_iterator& operator++();               // Next entry
+        const_iterator operator++(int);
+        const_iterator& operator--();               // Previous entry (the tail from end())
+        const_iterator operator--(int);
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+    };
 
 public:
     // Constructors
@@ -76,7 +213,10 @@ public:
     DLList& operator=(DLList&& other) noexcept;     // Move assignment: Transfer ownership
 
     // Public methods
-    void addBefore(IndexedToken data, size_t pos);  // Insert before pos
+    void addBefore(const IndexedToken& data, size_t pos); // Insert a copy before pos
+    void addBefore(IndexedToken&& data, size_t pos);      // Move data in before pos
+    template <typename... Args>
+    IndexedToken& emplaceBefore(size_t pos, Args&&... args); // Construct in place before pos
     bool remove(size_t pos);                        // Remove at pos
     IndexedToken& getIndexedTokenAt(size_t pos);    // Return non-const reference at pos
     const IndexedToken& getIndexedTokenAt(size_t pos) const; // Return const reference at pos
@@ -84,6 +224,87 @@ public:
     size_t size() const;                            // Return nodeCount
     bool isEmpty() const;                           // Check if empty
     void print(std::ostream& os) const;             // Output all IndexedTokens
+    void print(OutputBuffer& out) const;            // Append all IndexedTokens to output buffer
+    size_t lowerBound(const char* text, size_t length) const; // First pos not less than the view (list must be sorted)
+    void sort();                                    // Sort nodes by token text (relinks, data stays in place)
+    size_t bytesUsed() const;                       // Bytes of live nodes and nodeIndex entries
+    size_t bytesReserved() const;                   // Bytes of pool blocks and nodeIndex capacity
+    void shrinkToFit();                             // Release unused pool blocks and nodeIndex capacity
+    iterator begin();                               // Iterator at first entry
+    iterator end();                                 // Iterator past last entry
+    const_iterator begin() const;
+    const_iterator end() const;
+    template <typename... Args>
+    iterator insert_before(const_iterator it, Args&&... args); // Construct in place before it
+    iterator erase(const_iterator it);              // Remove at it, return the next entry
 };
 
+// Implements: Node* newNode(Args&&... args);
+// Helper: Construct a node in a pool slot, returning the slot if construction throws
+template <typename... Args>
+DLList::Node* DLList::newNode(Args&&... args) {
+    void* p = pool.allocate();
+    try {
+        return new (p) Node(std::forward<Args>(args)...);
+    } catch (...) {
+        pool.release(p);
+        throw;
+    }
+}
+
+// Implements: IndexedToken& emplaceBefore(size_t pos, Args&&... args);
+// emplaceBefore: Construct the IndexedToken directly in its node before pos, throw if invalid;
+// with a stale nodeIndex the node at pos is found by seek and the index stays stale
+template <typename... Args>
+IndexedToken& DLList::emplaceBefore(size_t pos, Args&&... args) {
+    if (pos > nodeCount) {
+        throw std::out_of_range("Position out of range");
+    }
+    Node* before = pos < nodeCount ? getNodeAt(pos) : nullptr;
+    Node* added = newNode(std::forward<Args>(args)...);
+    if (indexValid) {
+        try {
+            nodeIndex.insert(nodeIndex.begin() + pos, added);
+            INDEXER_COUNT(listIndexShifts, nodeCount - pos);
+        } catch (...) {
+            deleteNode(added);
+            throw;
+        }
+    } else {
+        // Nearby inserts continue from here instead of rebuilding the index
+        finger = added;
+        fingerPos = pos;
+    }
+    linkBefore(added, before);
+    INDEXER_COUNT(listInserts, 1);
+    return added->data;
+}
+
+// Implements: iterator insert_before(const_iterator it, Args&&... args);
+// insert_before: Construct the IndexedToken in a node before it; appending keeps nodeIndex
+// current, inserting elsewhere leaves it to be rebuilt by the next positional call
+template <typename... Args>
+DLList::iterator DLList::insert_before(const_iterator it, Args&&... args) {
+    Node* before = const_cast<Node*>(it.node);
+    Node* added = newNode(std::forward<Args>(args)...);
+    if (before || !indexValid) {
+        indexValid = false;
+        if (before && (before == head || before == finger)) {
+            ++fingerPos;        // The finger's position shifts by one
+        } else if (before) {
+            finger = nullptr;   // Position of the insert is unknown
+        }
+    } else {
+        try {
+            nodeIndex.push_back(added);
+        } catch (...) {
+            deleteNode(added);
+            throw;
+        }
+    }
+    linkBefore(added, before);
+    INDEXER_COUNT(listInserts, 1);
+    return iterator(added, this);
+}
+
 #endif // DLLIST_H
\ No newline at end of file
@@ -0,0 +1,179 @@
+// FileReader.cpp
+// Purpose: Implement mmap-backed and block-streamed file input.
+
+#include "FileReader.h"
+#include "Instrument.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Implements: bool readMore();
+// Private helper: Read up to one block after the valid bytes, doubling buffer when full
+bool FileReader::readMore() {
+    if (fill == capacity) {
+        size_t newCapacity = (capacity == 0) ? blockSize : capacity * 2;
+        char* newBuffer = new char[newCapacity];
+        if (fill > 0) {
+            std::memcpy(newBuffer, buffer, fill);
+        }
+        delete[] buffer;
+        buffer = newBuffer;
+        capacity = newCapacity;
+    }
+    size_t want = capacity - fill;
+    if (want > blockSize) {
+        want = blockSize;
+    }
+    ssize_t got;
+    do {
+        got = ::read(fd, buffer + fill, want);
+    } while (got < 0 && errno == EINTR);
+    if (got <= 0) {
+        eof = true;
+        return false;
+    }
+    fill += static_cast<size_t>(got);
+    return true;
+}
+
+// Implements: FileReader();
+// Default constructor: Closed reader
+FileReader::FileReader()
+    : fd(-1), ownsFd(false), mapped(nullptr), mappedSize(0), mappedDone(false),
+      buffer(nullptr), capacity(0), fill(0), consumed(0), eof(false) {}
+
+// Implements: ~FileReader();
+// Destructor: Release mapping, buffer and descriptor
+FileReader::~FileReader() {
+    close();
+}
+
+// Implements: bool open(const std::string& filename);
+// open: Map regular files, fall back to block reads for pipes and stdin
+bool FileReader::open(const std::string& filename) {
+    INDEXER_TIMED(readFile);
+    close();
+    if (filename == "-") {
+        fd = STDIN_FILENO;
+        ownsFd = false;
+        INDEXER_COUNT(filesOpened, 1);
+        return true;
+    }
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    ownsFd = true;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || S_ISDIR(st.st_mode)) {
+        close();
+        return false;
+    }
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            mapped = static_cast<char*>(p);
+            mappedSize = static_cast<size_t>(st.st_size);
+            ::madvise(p, mappedSize, MADV_SEQUENTIAL);
+        }
+    }
+    INDEXER_COUNT(filesOpened, 1);
+    return true;
+}
+
+// Implements: bool nextChunk(const char*& begin, const char*& end);
+// nextChunk: Return the mapping once, or the buffered bytes up to the last newline
+bool FileReader::nextChunk(const char*& begin, const char*& end) {
+    INDEXER_TIMED(readFile);
+    if (mapped) {
+        if (mappedDone) {
+            return false;
+        }
+        mappedDone = true;
+        begin = mapped;
+        end = mapped + mappedSize;
+        INDEXER_COUNT(bytesRead, mappedSize);
+        return true;
+    }
+    if (fd < 0) {
+        return false;
+    }
+    // Carry the partial line left over from the previous chunk to the front
+    if (consumed > 0) {
+        std::memmove(buffer, buffer + consumed, fill - consumed);
+        fill -= consumed;
+        consumed = 0;
+    }
+    size_t scanned = 0;
+    while (true) {
+        if (scanned < fill) {
+            const char* last = nullptr;
+            for (const char* p = buffer + fill; p > buffer + scanned; --p) {
+                if (p[-1] == '\n') {
+                    last = p;
+                    break;
+                }
+            }
+            if (last) {
+                consumed = static_cast<size_t>(last - buffer);
+                break;
+            }
+            scanned = fill;
+        }
+        if (eof || !readMore()) {
+            if (fill == 0) {
+                return false;
+            }
+            consumed = fill;
+            break;
+        }
+    }
+    begin = buffer;
+    end = buffer + consumed;
+    INDEXER_COUNT(bytesRead, consumed);
+    return true;
+}
+
+// Implements: void close();
+// close: Unmap/free and close descriptor, reset to closed state
+void FileReader::close() {
+    if (mapped) {
+        ::munmap(mapped, mappedSize);
+    }
+    if (ownsFd && fd >= 0) {
+        ::close(fd);
+    }
+    delete[] buffer;
+    fd = -1;
+    ownsFd = false;
+    mapped = nullptr;
+    mappedSize = 0;
+    mappedDone = false;
+    buffer = nullptr;
+    capacity = 0;
+    fill = 0;
+    consumed = 0;
+    eof = false;
+}
+
+// Implements: bool isMapped() const;
+// isMapped: Check if input is memory-mapped
+bool FileReader::isMapped() const {
+    return mapped != nullptr;
+}
+
+// Implements: size_t mappedLength() const;
+// mappedLength: Length of the mapping, 0 when streaming
+size_t FileReader::mappedLength() const {
+    return mapped ? mappedSize : 0;
+}
+
+// Implements: bool contains(const void* p) const;
+// contains: Check if p lies inside the mapping
+bool FileReader::contains(const void* p) const {
+    const char* c = static_cast<const char*>(p);
+    return mapped && c >= mapped && c < mapped + mappedSize;
+}
@@ -0,0 +1,47 @@
+// FileReader.h
+// Purpose: Declare the FileReader class, which hands out the bytes of a text file
+// in place. Regular files are memory-mapped and returned as a single chunk; pipes
+// and stdin ("-") are read in large blocks. Every chunk ends on a line boundary
+// (or at end of input), so callers can tokenize a chunk without carrying state.
+
+#ifndef FILEREADER_H
+#define FILEREADER_H
+
+#include <cstddef>
+#include <string>
+
+class FileReader {
+private:
+    static const size_t blockSize = 1 << 20;  // Read size for non-mappable input
+
+    int fd;                 // Open file descriptor (-1 when closed)
+    bool ownsFd;            // False for stdin
+    char* mapped;           // Mapped file contents (nullptr when streaming)
+    size_t mappedSize;      // Length of the mapping
+    bool mappedDone;        // Mapped chunk already handed out
+    char* buffer;           // Stream buffer
+    size_t capacity;        // Allocated size of buffer
+    size_t fill;            // Valid bytes in buffer
+    size_t consumed;        // Bytes at the front of buffer returned by the last chunk
+    bool eof;               // Underlying stream exhausted
+    bool readMore();        // Private helper: read one block, growing buffer if full
+
+public:
+    // Constructors
+    FileReader();                                   // Default constructor: Closed reader
+    FileReader(const FileReader& other) = delete;   // Copy constructor: Deleted
+    FileReader& operator=(const FileReader& other) = delete; // Copy assignment: Deleted
+
+    // Destructor
+    ~FileReader();
+
+    // Public methods
+    bool open(const std::string& filename);         // Open file ("-" for stdin), false on failure
+    bool nextChunk(const char*& begin, const char*& end); // Next line-aligned chunk, false at end
+    void close();                                   // Unmap/free and close descriptor
+    bool isMapped() const;                          // Check if input is memory-mapped
+    size_t mappedLength() const;                    // Bytes mapped (0 when streaming)
+    bool contains(const void* p) const;             // Check if p points into the mapping
+};
+
+#endif // FILEREADER_H
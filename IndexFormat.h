@@ -0,0 +1,90 @@
+// IndexFormat.h
+// Purpose: Describe the on-disk index written by Indexer::save and mapped by Indexer::load.
+// All integers are in the writer's native byte order; endianTag lets a reader on a machine
+// with the other order refuse the file instead of misreading it.
+//
+// Layout (every region starts on an 8-byte boundary):
+//   Header                     fixed size, checksum covers every byte after it
+//   SectionRef[sectionCount]   entries of section s are [firstEntry, firstEntry + entryCount)
+//   Entry[tokenCount]          sorted dictionary, section by section, in section order
+//   ListRef[tokenCount]        document runs of each entry (corpus indexes only)
+//   text                       token bytes, each followed by '\0' so tokens can point into it
+//   postings                   IntList encodings: varint bytes, then 4-byte aligned checkpoints
+//   names                      u32 length + bytes of the source file, u32 count, then each document
+
+#ifndef INDEXFORMAT_H
+#define INDEXFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IndexFormat {
+
+const char magic[8] = { 'T', 'F', 'I', 'N', 'D', 'E', 'X', '\0' };
+const uint32_t version = 1;
+const uint32_t endianTag = 0x01020304;      // Reads as 0x04030201 with the other byte order
+const uint32_t flagCorpus = 1;              // Document runs region is present
+const uint32_t flagDedupLines = 2;          // Postings were recorded with dedupLines on
+const uint32_t flagFoldCase = 4;            // Tokens were stored case-folded (Normalizer::foldCase)
+const uint32_t flagStripPunctuation = 8;    // Tokens were stored without edge punctuation
+
+// Fixed file header
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianTag;
+    uint32_t sectionCount;
+    uint32_t flags;
+    uint64_t tokenCount;
+    uint64_t fileSize;
+    uint64_t sectionsOffset;
+    uint64_t entriesOffset;
+    uint64_t docRunsOffset;                 // Equals textOffset unless flagCorpus is set
+    uint64_t textOffset;
+    uint64_t postingsOffset;
+    uint64_t namesOffset;
+    uint64_t checksum;                      // FNV-1a 64 of bytes [sizeof(Header), fileSize)
+};
+
+// Range of the dictionary belonging to one section
+struct SectionRef {
+    uint64_t firstEntry;
+    uint64_t entryCount;
+};
+
+// One encoded IntList inside the postings region (count 0: no list)
+struct ListRef {
+    uint64_t offset;                        // Encoded bytes, relative to postingsOffset
+    uint32_t byteCount;
+    uint32_t count;                         // Number of values
+    int32_t last;                           // Last value (delta base for appends)
+    uint32_t reserved;
+};
+
+// One dictionary entry
+struct Entry {
+    uint64_t textOffset;                    // Relative to textOffset
+    uint32_t textLength;
+    uint32_t reserved;
+    ListRef lines;
+};
+
+const uint64_t checksumBasis = 14695981039346656037ULL;
+
+// FNV-1a 64 over size bytes, continuing from hash
+inline uint64_t checksum(const unsigned char* data, size_t size, uint64_t hash = checksumBasis) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Round offset up to a multiple of alignment (a power of two)
+inline uint64_t align(uint64_t offset, uint64_t alignment) {
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace IndexFormat
+
+#endif // INDEXFORMAT_H
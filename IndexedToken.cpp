@@ -8,50 +8,137 @@
 // 2. Implement parameterized constructors
 //    - Constructor (const char*, int): Initialize token with text, append lineNumber to lines.
 //    - Constructor (Token, int): Initialize token, append lineNumber to lines.
+//    - Constructor (const char*, size_t, int): Initialize token from a view, append lineNumber to lines.
+//    - Constructor (const char*, size_t, int, Arena&): Same, with token bytes stored in arena.
+//    - Constructor (Token, IntList): Take over token and lines as they are.
 
-// 3. Implement appendLineNumber
+// 3. Implement copy/move constructors, destructor and assignment operators
+//    - Deep copy or transfer docRuns; Token and IntList handle themselves.
+
+// 4. Implement appendLineNumber and shrinkToFit
 //    - Append lineNumber to lines.
+//    - shrinkToFit: IntList::shrinkToFit on lines and docRuns.
 
-// 4. Implement getToken
+// 5. Implement getToken
 //    - Return token by const reference.
 //    - Mark as const.
 
-// 5. Implement getLineNumbers
+// 6. Implement getLineNumbers
 //    - Return lines by const reference.
 //    - Mark as const.
 
-// 6. Implement print
-//    - Output token followed by lines to ostream.
+// 7. Implement print
+//    - Output token followed by lines to ostream; corpus postings print as docId:line.
+//    - OutputBuffer overload: same bytes through the buffer.
 //    - Mark as const.
 
-// 7. Implement compare (const char*)
+// 8. Implement compare (const char*)
 //    - Compare token’s text with C-string using std::strcmp.
 //    - Mark as const.
 
-// 8. Implement compare (const IndexedToken&)
-//    - Compare token with other.token using Token::compare.
+// 9. Implement compare (const char*, size_t)
+//    - Compare token’s text with a view using Token::compare.
 //    - Mark as const.
 
+// 10. Implement compare (const IndexedToken&)
+//     - Compare token with other.token using Token::compare.
+//     - Mark as const.
+
+// 11. Implement appendPosting, assignDocument, hasDocuments, getDocumentRuns, setDocumentRuns
+//     - appendPosting: Start a new run when docId differs from the last run, then append the line.
+//     - assignDocument: Replace any runs with one run covering every line.
+//     - setDocumentRuns: Take over a run list as it is.
+
 #include "IndexedToken.h"
 
 // Implements: IndexedToken(const char* text, int lineNumber);
 // Parameterized constructor: Initialize token with text, append lineNumber
-IndexedToken::IndexedToken(const char* text, int lineNumber) : token(text) {
+IndexedToken::IndexedToken(const char* text, int lineNumber) : token(text), docRuns(nullptr) {
     lines.append(lineNumber);
 }
 
 // Implements: IndexedToken(Token token, int lineNumber);
 // Parameterized constructor: Initialize with Token, append lineNumber
-IndexedToken::IndexedToken(Token token, int lineNumber) : token(std::move(token)) {
+IndexedToken::IndexedToken(Token token, int lineNumber) : token(std::move(token)), docRuns(nullptr) {
+    lines.append(lineNumber);
+}
+
+// Implements: IndexedToken(const char* text, size_t length, int lineNumber);
+// Parameterized constructor: Initialize token from a view, append lineNumber
+IndexedToken::IndexedToken(const char* text, size_t length, int lineNumber)
+    : token(text, length), docRuns(nullptr) {
     lines.append(lineNumber);
 }
 
+// Implements: IndexedToken(const char* text, size_t length, int lineNumber, Arena& arena);
+// Parameterized constructor: Initialize token in arena, append lineNumber
+IndexedToken::IndexedToken(const char* text, size_t length, int lineNumber, Arena& arena)
+    : token(text, length, arena), docRuns(nullptr) {
+    lines.append(lineNumber);
+}
+
+// Implements: IndexedToken(Token token, IntList lines);
+// Parameterized constructor: Adopt token and line list
+IndexedToken::IndexedToken(Token token, IntList lines)
+    : token(std::move(token)), lines(std::move(lines)), docRuns(nullptr) {}
+
+// Implements: IndexedToken(const IndexedToken& other);
+// Copy constructor: Deep copy, including document runs
+IndexedToken::IndexedToken(const IndexedToken& other)
+    : token(other.token), lines(other.lines),
+      docRuns(other.docRuns ? new IntList(*other.docRuns) : nullptr) {}
+
+// Implements: IndexedToken(IndexedToken&& other) noexcept;
+// Move constructor: Transfer ownership, leave other without document runs
+IndexedToken::IndexedToken(IndexedToken&& other) noexcept
+    : token(std::move(other.token)), lines(std::move(other.lines)), docRuns(other.docRuns) {
+    other.docRuns = nullptr;
+}
+
+// Implements: ~IndexedToken();
+// Destructor: Deallocate document runs
+IndexedToken::~IndexedToken() {
+    delete docRuns;
+}
+
+// Implements: IndexedToken& operator=(const IndexedToken& other);
+// Copy assignment: Deep copy, handle self-assignment
+IndexedToken& IndexedToken::operator=(const IndexedToken& other) {
+    if (this != &other) {
+        IndexedToken copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+// Implements: IndexedToken& operator=(IndexedToken&& other) noexcept;
+// Move assignment: Transfer ownership, handle self-assignment
+IndexedToken& IndexedToken::operator=(IndexedToken&& other) noexcept {
+    if (this != &other) {
+        token = std::move(other.token);
+        lines = std::move(other.lines);
+        delete docRuns;
+        docRuns = other.docRuns;
+        other.docRuns = nullptr;
+    }
+    return *this;
+}
+
 // Implements: void appendLineNumber(size_t lineNumber);
 // Append: Add lineNumber to lines
 void IndexedToken::appendLineNumber(size_t lineNumber) {
     lines.append(lineNumber);
 }
 
+// Implements: void shrinkToFit();
+// shrinkToFit: Trim lines and document runs to their encoded size
+void IndexedToken::shrinkToFit() {
+    lines.shrinkToFit();
+    if (docRuns) {
+        docRuns->shrinkToFit();
+    }
+}
+
 // Implements: const Token& getToken() const;
 // getToken: Return token by const reference
 const Token& IndexedToken::getToken() const {
@@ -69,7 +156,52 @@ const IntList& IndexedToken::getLineNumbers() const {
 void IndexedToken::print(std::ostream& os) const {
     token.print(os);
     os << ": ";
-    lines.print(os);
+    if (!docRuns) {
+        lines.print(os);
+        return;
+    }
+    // Runs are (first posting index, docId) pairs in posting order
+    IntList::const_iterator run = docRuns->begin();
+    size_t index = 0;
+    int docId = 0;
+    for (IntList::const_iterator line = lines.begin(); line != lines.end(); ++line, ++index) {
+        if (run != docRuns->end() && static_cast<size_t>(*run) == index) {
+            ++run;
+            docId = *run;
+            ++run;
+        }
+        if (index > 0) {
+            os << " ";
+        }
+        os << docId << ":" << *line;
+    }
+}
+
+// Implements: void print(OutputBuffer& out) const;
+// print: Append token followed by lines
+void IndexedToken::print(OutputBuffer& out) const {
+    token.print(out);
+    out.append(": ", 2);
+    if (!docRuns) {
+        lines.print(out);
+        return;
+    }
+    IntList::const_iterator run = docRuns->begin();
+    size_t index = 0;
+    int docId = 0;
+    for (IntList::const_iterator line = lines.begin(); line != lines.end(); ++line, ++index) {
+        if (run != docRuns->end() && static_cast<size_t>(*run) == index) {
+            ++run;
+            docId = *run;
+            ++run;
+        }
+        if (index > 0) {
+            out.append(' ');
+        }
+        out.appendInt(docId);
+        out.append(':');
+        out.appendInt(*line);
+    }
 }
 
 // Implements: int compare(const char* other) const;
@@ -78,8 +210,59 @@ int IndexedToken::compare(const char* other) const {
     return std::strcmp(token.c_str(), other ? other : "");
 }
 
+// Implements: int compare(const char* other, size_t length) const;
+// compare: Compare token’s text with a view
+int IndexedToken::compare(const char* other, size_t length) const {
+    return token.compare(other, length);
+}
+
 // Implements: int compare(const IndexedToken& other) const;
 // compare: Compare token with other.token
 int IndexedToken::compare(const IndexedToken& other) const {
     return token.compare(other.token);
-}
\ No newline at end of file
+}
+
+// Implements: void appendPosting(int docId, int lineNumber);
+// appendPosting: Start a run when docId changes, then append lineNumber
+void IndexedToken::appendPosting(int docId, int lineNumber) {
+    if (!docRuns) {
+        docRuns = new IntList();
+    }
+    if (docRuns->isEmpty() || docRuns->back() != docId) {
+        docRuns->append(static_cast<int>(lines.getSize()));
+        docRuns->append(docId);
+    }
+    lines.append(lineNumber);
+}
+
+// Implements: void assignDocument(int docId);
+// assignDocument: One run covering every current line
+void IndexedToken::assignDocument(int docId) {
+    if (!docRuns) {
+        docRuns = new IntList();
+    }
+    docRuns->clear();
+    docRuns->append(0);
+    docRuns->append(docId);
+}
+
+// Implements: bool hasDocuments() const;
+// hasDocuments: Check if postings carry document ids
+bool IndexedToken::hasDocuments() const {
+    return docRuns != nullptr;
+}
+
+// Implements: const IntList* getDocumentRuns() const;
+// getDocumentRuns: Return document runs (nullptr outside corpus mode)
+const IntList* IndexedToken::getDocumentRuns() const {
+    return docRuns;
+}
+
+// Implements: void setDocumentRuns(IntList runs);
+// setDocumentRuns: Replace document runs with runs
+void IndexedToken::setDocumentRuns(IntList runs) {
+    if (!docRuns) {
+        docRuns = new IntList();
+    }
+    *docRuns = std::move(runs);
+}
@@ -1,5 +1,7 @@
 // TO-DO for IndexedToken.h
 // Purpose: Declare the IndexedToken class to aggregate a Token and its list of line numbers.
+// In a multi-file corpus each posting is a (docId, line) pair: lines holds every line in
+// document order and docRuns marks where each document's run of lines starts.
 
 // 1. Set up include guard
 //    - Add header guard to prevent multiple inclusions.
@@ -12,27 +14,38 @@
 
 // 3. Declare IndexedToken class
 //    - Define private members: token (Token), lines (IntList).
+//    - Define private member docRuns (IntList*): (first posting index, docId) pairs, nullptr outside corpus mode.
 
 // 4. Declare constructors
 //    - Parameterized constructor (const char*, int): Initialize token and add lineNumber.
 //    - Parameterized constructor (Token, int): Initialize token and add lineNumber.
-//    - Copy constructor: Deep copy (defaulted).
-//    - Move constructor: Transfer ownership (defaulted, noexcept).
+//    - Parameterized constructor (const char*, size_t, int): Initialize token from a view and add lineNumber.
+//    - Parameterized constructor (const char*, size_t, int, Arena&): Same, with token bytes stored in arena.
+//    - Parameterized constructor (Token, IntList): Adopt an existing token and line list (e.g. loaded from disk).
+//    - Copy constructor: Deep copy (including docRuns).
+//    - Move constructor: Transfer ownership (noexcept).
 
 // 5. Declare destructor
-//    - Defaulted to delegate to Token and IntList.
+//    - Deallocate docRuns; Token and IntList clean up themselves.
 
 // 6. Declare assignment operators
-//    - Copy assignment: Deep copy (defaulted).
-//    - Move assignment: Transfer ownership (defaulted, noexcept).
+//    - Copy assignment: Deep copy.
+//    - Move assignment: Transfer ownership (noexcept).
 
 // 7. Declare public methods
 //    - appendLineNumber: Add lineNumber to lines.
+//    - shrinkToFit: Trim lines (and docRuns) to their encoded size.
 //    - getToken (const): Return token by const reference.
 //    - getLineNumbers (const): Return lines by const reference.
-//    - print (const): Output token and lines to ostream.
+//    - print (const): Output token and lines to ostream, or to an OutputBuffer (fast path).
 //    - compare (const char*, const): Compare token’s text with C-string.
+//    - compare (const char*, size_t, const): Compare token’s text with a view.
 //    - compare (const IndexedToken&, const): Compare token with other.token.
+//    - appendPosting: Add a (docId, lineNumber) posting (corpus mode).
+//    - assignDocument: Attribute all current lines to one document (switch to corpus mode).
+//    - hasDocuments (const): Check if postings carry document ids.
+//    - getDocumentRuns (const): Return docRuns (nullptr outside corpus mode).
+//    - setDocumentRuns: Replace docRuns with an existing run list (switch to corpus mode).
 
 // 8. Close include guard
 
@@ -48,28 +61,40 @@ class IndexedToken {
 private:
     Token token;        // The token
     IntList lines;      // List of line numbers
+    IntList* docRuns;   // (first posting index, docId) pairs, nullptr outside corpus mode
 
 public:
     // Constructors
     IndexedToken(const char* text, int lineNumber);     // Initialize with C-string and line number
     IndexedToken(Token token, int lineNumber);          // Initialize with Token and line number
-    IndexedToken(const IndexedToken& other) = default;  // Copy constructor: Deep copy
-    IndexedToken(IndexedToken&& other) noexcept = default; // Move constructor: Transfer ownership
+    IndexedToken(const char* text, size_t length, int lineNumber); // Initialize with view and line number
+    IndexedToken(const char* text, size_t length, int lineNumber, Arena& arena); // Token bytes stored in arena
+    IndexedToken(Token token, IntList lines);           // Adopt token and line list
+    IndexedToken(const IndexedToken& other);            // Copy constructor: Deep copy
+    IndexedToken(IndexedToken&& other) noexcept;        // Move constructor: Transfer ownership
 
     // Destructor
-    ~IndexedToken() = default;                          // Defaulted to delegate to Token and IntList
+    ~IndexedToken();                                    // Deallocate docRuns
 
     // Assignment operators
-    IndexedToken& operator=(const IndexedToken& other) = default; // Copy assignment: Deep copy
-    IndexedToken& operator=(IndexedToken&& other) noexcept = default; // Move assignment: Transfer ownership
+    IndexedToken& operator=(const IndexedToken& other); // Copy assignment: Deep copy
+    IndexedToken& operator=(IndexedToken&& other) noexcept; // Move assignment: Transfer ownership
 
     // Public methods
     void appendLineNumber(size_t lineNumber);           // Append lineNumber to lines
+    void shrinkToFit();                                 // Release unused posting capacity
     const Token& getToken() const;                      // Return token by const reference
     const IntList& getLineNumbers() const;              // Return lines by const reference
     void print(std::ostream& os) const;                 // Output token and lines to stream
+    void print(OutputBuffer& out) const;                // Append token and lines to output buffer
     int compare(const char* other) const;               // Compare token’s text with C-string
+    int compare(const char* other, size_t length) const; // Compare token’s text with a view
     int compare(const IndexedToken& other) const;       // Compare token with other.token
+    void appendPosting(int docId, int lineNumber);      // Append (docId, lineNumber)
+    void assignDocument(int docId);                     // Attribute all lines to docId
+    bool hasDocuments() const;                          // Check if postings carry document ids
+    const IntList* getDocumentRuns() const;             // Return docRuns (nullptr outside corpus mode)
+    void setDocumentRuns(IntList runs);                 // Replace docRuns with runs
 };
 
 #endif // INDEXEDTOKEN_H
\ No newline at end of file
@@ -3,82 +3,492 @@
 
 // 1. Include necessary headers
 //    - Include Indexer.h for class declaration.
-//    - Include <fstream> for file reading.
-//    - Include <sstream> for tokenization.
+//    - Include FileReader.h for mmap/block file reading.
+//    - Include Tokenizer.h for in-place tokenization.
+//    - Include IndexFormat.h and <fstream> for saving and loading index files.
 //    - Include <cctype> for std::tolower and std::isalpha.
 //    - Include <iostream> for error messages and output.
 
 // 2. Implement default constructor
-//    - Initialize sections as empty, currentFilename as empty.
+//    - Initialize sections as empty, currentFilename as empty, ingest mode on.
 
-// 3. Implement processToken (const char*, int)
-//    - Map token to section, check for existing token, update or insert.
+// 3. Implement processToken (const char*, int) and (const char*, size_t, int)
+//    - The C-string overload delegates to the view overload.
+//    - Map token to section.
+//    - Ingest mode: look up the token in the section's TokenTable, append new tokens at the tail.
+//    - Otherwise: binary search for existing token, update or insert in order.
 
 // 4. Implement processToken (Token, int)
 //    - Map token to section, check for existing token, update or insert.
 
 // 5. Implement processTextFile
-//    - Open file, clear index, read lines, tokenize, call processToken.
+//    - Open file (return false if unreadable), clear index, scan line-aligned chunks in place,
+//      call processToken on each span.
+//    - Large mapped files with threadCount > 1 go through indexParallel instead.
 
 // 6. Implement clear
-//    - Clear all sections and currentFilename.
+//    - Clear all sections and currentFilename, then rewind the arena (its blocks are reused by the next file).
 
 // 7. Implement isEmpty
 //    - Check if all sections are empty.
 //    - Mark as const.
 
 // 8. Implement print
-//    - Output all sections to ostream.
+//    - Output all sections to ostream through an OutputBuffer (itoa, large writes).
+//    - OutputBuffer overload: append all sections (callers choose the sink, e.g. a descriptor).
+//      With threadCount > 1 and a large index, render sections into per-section buffers in
+//      parallel and emit them in order; output is identical to the sequential path.
+//    - printSection: Header, tokens and blank line of one non-empty section.
 //    - Mark as const.
 
 // 9. Implement displayAllTokens
 //    - Call print(std::cout).
 //    - Mark as const.
 
-// 10. Implement listByLength
-//     - Display tokens of specified length across all sections.
+// 10. Implement listByLength, listMatching, listRange and printQueryResult
+//     - Display tokens of specified length across all sections (from tokensByLength).
 //     - Mark as const.
 
 // 11. Implement ViewBySection
 //     - Display tokens in specified section (by letter).
 //     - Mark as const.
 
+// 12. Implement sectionFor and ensureSorted
+//     - sectionFor: 0-25 for letters (case-insensitive), 26 otherwise.
+//     - ensureSorted: Sort a section once before its first ordered access.
+
+// 13. Implement setIngestMode and isIngestMode
+
+// 14. Implement addToLengthIndex and lengthBucket
+//     - addToLengthIndex: Append the token to its bucket, flag the bucket if order breaks.
+//     - lengthBucket: Sort the bucket once if flagged, return it (nullptr if no such length).
+
+// 15. Implement appendLine, setDedupLines, isDedupLines, setNormalization and getNormalization
+//     - appendLine: Skip the line if dedup is on and it is already the token's last line.
+//     - setNormalization: Normalizer flags applied once per token in processToken (default none);
+//       partial indexes, saved files and find() use the same flags.
+
+// 16. Implement indexRange, indexParallel and mergeSection
+//     - indexRange: Tokenize a line-aligned range in batches and call processToken.
+//     - indexParallel: Split at newlines, index each chunk into a partial Indexer on its own thread
+//       (lines relative to the chunk), adopt the partial arenas, then merge section by section in
+//       parallel, offsetting lines by the prefix count of newlines in earlier chunks.
+//     - mergeSection: Find-or-append each partial token through the section's TokenTable.
+
+// 17. Implement setThreadCount and getThreadCount
+
+// 18. Implement processCorpus, addFile, convertToCorpus, isCorpus, documentCount, documentName
+//     - processCorpus: Clear, then index files into partial indexes on the thread pool in batches,
+//       assign docIds in list order (skipping unreadable files) and merge each batch by section.
+//     - addFile: Index one file into a partial index and merge it under the next docId.
+//     - convertToCorpus: Attribute an existing single-file index to document 0.
+
+// 19. Implement save and load
+//     - save: Sort every section, then write header, section table, dictionary, text, postings
+//       and names in one pass per region, checksumming as it goes. The file is written beside
+//       the target and renamed over it, so an index that is currently loaded stays mapped intact.
+//     - load: Map the file, validate header, bounds and (optionally) the checksum before touching
+//       the index, then link one node per dictionary entry whose Token and IntLists point into the
+//       mapping. Nothing is decoded or copied; a loaded list is copied only when it is appended to.
+
+// 20. Implement find, tokensByLength and tokensInSection
+//     - find: Look the text up in its section's TokenTable.
+
+// 21. Implement followFile, refresh and isFollowing (tail mode)
+//     - followFile: Clear and index the complete lines of a regular file (the unterminated last line
+//       waits for its newline), remembering the file identity, byte offset, next line number and
+//       the last bytes ingested.
+//     - refresh: Index only the complete lines appended since the last call, read with pread in
+//       blocks. If the file was replaced (new inode), truncated below the offset or rewritten in
+//       place (remembered bytes differ), re-follow it from the start.
+//     - ingestAppended / tailMatches / rememberTail: Private helpers for the above.
+
+// 22. Implement tokensWithPrefix, tokensInRange, tokensMatching, listMatching and listRange
+//     - Queries are case-folded like ingested tokens. Each section is searched by binary search
+//       (lowerBound) for its first candidate and read forward only while candidates can match,
+//       so a query costs O(log n) per section visited plus the size of its result.
+//     - tokensWithPrefix: One section (the prefix's first character), from lowerBound(prefix).
+//     - tokensInRange: Tokens t with first <= t <= last in byte order, section by section.
+//     - tokensMatching: '*' matches any run, '?' one byte. The literal text before the first
+//       wildcard is used as a prefix seek; a leading wildcard has no prefix and scans every token.
+//     - collectPrefix: Private helper appending one section's prefix run.
+//     - listMatching / listRange: Display results like listByLength.
+
+// 23. Implement linesMatching and listQuery
+//     - linesMatching: Evaluate a Boolean expression with Query (posting intersection).
+//     - listQuery: Display the matching lines on one line, docId:line in corpus mode.
+//     - tokensByLength: Concatenate the sorted length buckets of every section.
+//     - tokensInSection: Sort the section if needed and collect its tokens in order.
+
+// 24. Implement noteFrequency, promoteFrequent, mostFrequent and listMostFrequent
+//     - Every place that adds postings reports the token's previous count to noteFrequency. Each
+//       section keeps its frequentCapacity most frequent tokens exactly, plus frequentFloor, the most
+//       postings any other token has; only a token passing the floor costs more than a compare.
+//     - mostFrequent: Rank the tracked tokens (count, then text). A section is read in full only if
+//       an untracked token could still make the result (k > frequentCapacity, or its floor reaches
+//       the k-th count), so on large inputs the answer costs O(27 * frequentCapacity).
+//     - listMostFrequent: Display "count token" lines.
+
+// 25. Instrument the ingest path (Instrument.h; compiled out unless INDEXER_INSTRUMENT is defined)
+//     - loadTextFile / followFile time indexFile; indexRange laps a Stopwatch between tokenize and
+//       processTokens; ensureSorted, mergeSection, save and load time their phases.
+//     - processToken counts tokens found and inserted; appendLine counts postings kept after dedup.
+
+// 26. Implement memoryUsage, listMemoryUsage, compact, setMemoryBudget, getMemoryBudget, checkMemoryBudget
+//     - memoryUsage: Walk every token once. Text in a loaded index file and inline or borrowed postings
+//       cost nothing beyond the node; arena bytes that no live token points at (texts of partial
+//       indexes folded into existing tokens, blocks kept by clear) are allocator slack.
+//     - compact: IndexedToken::shrinkToFit on every token, trim the lists, length buckets and arena.
+//     - checkMemoryBudget: Run every budgetCheckTokens tokens, after each ingest and after each partial
+//       index is merged. Compare estimatedHeapBytes (arena, pools, tables, buckets and the running
+//       postingBytes, no token walk) with the budget; only past it measure exactly, compact if posting
+//       slack is worth it (1/16 of the heap bytes) and warn once if still over. The next exact
+//       measurement waits until the estimate grows by another eighth, so the walks stay logarithmic.
+//     - postingBytes: appendLine and mergeSection add each list's growth while a budget is set;
+//       recountPostings resets it from the tokens (setMemoryBudget, compact, convertToCorpus).
+
 #include "Indexer.h"
-#include <fstream>
-#include <sstream>
+#include "FileReader.h"
+#include "Tokenizer.h"
+#include "Parallel.h"
+#include "IndexFormat.h"
+#include "Normalizer.h"
+#include "Instrument.h"
+#include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Sequential writer tracking the file offset and the checksum of everything after the header
+class IndexWriter {
+private:
+    std::ofstream& out;
+    uint64_t position;
+    uint64_t hash;
+
+public:
+    explicit IndexWriter(std::ofstream& out)
+        : out(out), position(sizeof(IndexFormat::Header)), hash(IndexFormat::checksumBasis) {}
+
+    void write(const void* data, size_t size) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        hash = IndexFormat::checksum(static_cast<const unsigned char*>(data), size, hash);
+        position += size;
+    }
+
+    // Write zero bytes up to offset
+    void padTo(uint64_t offset) {
+        static const char zeros[8] = {};
+        while (position < offset) {
+            uint64_t n = offset - position;
+            write(zeros, static_cast<size_t>(n < sizeof(zeros) ? n : sizeof(zeros)));
+        }
+    }
+
+    uint64_t offset() const { return position; }
+    uint64_t checksum() const { return hash; }
+};
+
+// Reserve room for list at cursor in the postings region, advance cursor past it
+IndexFormat::ListRef placeList(const IntList& list, uint64_t& cursor) {
+    IntList::Encoded encoding = list.encoded();
+    IndexFormat::ListRef ref = IndexFormat::ListRef();
+    ref.offset = cursor;
+    ref.byteCount = encoding.byteCount;
+    ref.count = encoding.count;
+    ref.last = encoding.last;
+    cursor += encoding.byteCount;
+    size_t checkpoints = IntList::checkpointCount(encoding.count);
+    if (checkpoints > 0) {
+        cursor = IndexFormat::align(cursor, 4) + checkpoints * IntList::checkpointBytes();
+    }
+    return ref;
+}
+
+// Write list as placed by placeList (postings region starts 8-byte aligned)
+void writeList(IndexWriter& writer, const IntList& list) {
+    IntList::Encoded encoding = list.encoded();
+    writer.write(encoding.bytes, encoding.byteCount);
+    size_t checkpoints = IntList::checkpointCount(encoding.count);
+    if (checkpoints > 0) {
+        writer.padTo(IndexFormat::align(writer.offset(), 4));
+        writer.write(encoding.checkpoints, checkpoints * IntList::checkpointBytes());
+    }
+}
+
+// Write a u32 length followed by the bytes of str
+void writeName(IndexWriter& writer, const std::string& str) {
+    uint32_t length = static_cast<uint32_t>(str.size());
+    writer.write(&length, sizeof(length));
+    writer.write(str.data(), str.size());
+}
+
+// Check that a list lies inside the postings region
+bool listFits(const IndexFormat::ListRef& ref, uint64_t postingsSize) {
+    if (ref.offset > postingsSize || ref.byteCount > postingsSize - ref.offset) {
+        return false;
+    }
+    size_t checkpoints = IntList::checkpointCount(ref.count);
+    if (checkpoints == 0) {
+        return true;
+    }
+    uint64_t start = IndexFormat::align(ref.offset + ref.byteCount, 4);
+    return start <= postingsSize &&
+           checkpoints <= (postingsSize - start) / IntList::checkpointBytes();
+}
+
+// View of a list inside the mapped postings region
+IntList borrowList(const unsigned char* postings, const IndexFormat::ListRef& ref) {
+    IntList::Encoded encoding;
+    encoding.bytes = postings + ref.offset;
+    encoding.byteCount = ref.byteCount;
+    encoding.count = ref.count;
+    encoding.last = ref.last;
+    encoding.checkpoints = postings + IndexFormat::align(ref.offset + ref.byteCount, 4);
+    return IntList::borrow(encoding);
+}
+
+// Read a u32 length and that many bytes at cursor, false if it runs past end
+bool readName(const unsigned char*& cursor, const unsigned char* end, std::string& name) {
+    uint32_t length;
+    if (static_cast<size_t>(end - cursor) < sizeof(length)) {
+        return false;
+    }
+    std::memcpy(&length, cursor, sizeof(length));
+    cursor += sizeof(length);
+    if (static_cast<size_t>(end - cursor) < length) {
+        return false;
+    }
+    name.assign(reinterpret_cast<const char*>(cursor), length);
+    cursor += length;
+    return true;
+}
+
+// Validate a mapped index file and read its names; return an error message or nullptr
+const char* checkIndexFile(const unsigned char* base, size_t size, bool verifyChecksum,
+                           std::string& source, std::vector<std::string>& documents) {
+    IndexFormat::Header header;
+    if (size < sizeof(header)) {
+        return "file too small";
+    }
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, IndexFormat::magic, sizeof(header.magic)) != 0) {
+        return "not an index file";
+    }
+    if (header.endianTag != IndexFormat::endianTag) {
+        return "written with a different byte order";
+    }
+    if (header.version != IndexFormat::version) {
+        return "unsupported format version";
+    }
+    if (header.sectionCount != 27 || header.fileSize != size) {
+        return "corrupt header";
+    }
+    if (header.sectionsOffset < sizeof(header) || header.entriesOffset > size ||
+        header.entriesOffset < header.sectionsOffset ||
+        header.entriesOffset - header.sectionsOffset < 27 * sizeof(IndexFormat::SectionRef) ||
+        header.sectionsOffset % 8 != 0 || header.entriesOffset % 8 != 0 ||
+        header.tokenCount > (size - header.entriesOffset) / sizeof(IndexFormat::Entry) ||
+        header.docRunsOffset < header.entriesOffset + header.tokenCount * sizeof(IndexFormat::Entry) ||
+        header.docRunsOffset % 8 != 0 || header.textOffset < header.docRunsOffset ||
+        ((header.flags & IndexFormat::flagCorpus) &&
+         header.textOffset - header.docRunsOffset < header.tokenCount * sizeof(IndexFormat::ListRef)) ||
+        header.postingsOffset < header.textOffset || header.postingsOffset % 8 != 0 ||
+        header.namesOffset < header.postingsOffset || header.namesOffset > size) {
+        return "corrupt header";
+    }
+    if (verifyChecksum &&
+        IndexFormat::checksum(base + sizeof(header), size - sizeof(header)) != header.checksum) {
+        return "checksum mismatch";
+    }
+    uint64_t next = 0;
+    for (int i = 0; i < 27; ++i) {
+        IndexFormat::SectionRef ref;
+        std::memcpy(&ref, base + header.sectionsOffset + i * sizeof(ref), sizeof(ref));
+        if (ref.firstEntry != next || ref.entryCount > header.tokenCount - next) {
+            return "corrupt section table";
+        }
+        next += ref.entryCount;
+    }
+    if (next != header.tokenCount) {
+        return "corrupt section table";
+    }
+    const char* text = reinterpret_cast<const char*>(base + header.textOffset);
+    uint64_t textSize = header.postingsOffset - header.textOffset;
+    uint64_t postingsSize = header.namesOffset - header.postingsOffset;
+    for (uint64_t i = 0; i < header.tokenCount; ++i) {
+        IndexFormat::Entry entry;
+        std::memcpy(&entry, base + header.entriesOffset + i * sizeof(entry), sizeof(entry));
+        if (entry.textOffset >= textSize || entry.textLength >= textSize - entry.textOffset ||
+            text[entry.textOffset + entry.textLength] != '\0' || !listFits(entry.lines, postingsSize)) {
+            return "corrupt dictionary entry";
+        }
+        if (header.flags & IndexFormat::flagCorpus) {
+            IndexFormat::ListRef runs;
+            std::memcpy(&runs, base + header.docRunsOffset + i * sizeof(runs), sizeof(runs));
+            if (!listFits(runs, postingsSize)) {
+                return "corrupt document runs";
+            }
+        }
+    }
+    const unsigned char* cursor = base + header.namesOffset;
+    const unsigned char* end = base + size;
+    uint32_t count;
+    if (!readName(cursor, end, source) || static_cast<size_t>(end - cursor) < sizeof(count)) {
+        return "corrupt document names";
+    }
+    std::memcpy(&count, cursor, sizeof(count));
+    cursor += sizeof(count);
+    documents.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string name;
+        if (!readName(cursor, end, name)) {
+            return "corrupt document names";
+        }
+        documents.push_back(name);
+    }
+    return nullptr;
+}
+
+// Check if text matches pattern, where '*' matches any run of bytes and '?' exactly one.
+// Greedy with backtracking to the last '*': O(pattern * text) worst case, linear in practice.
+bool wildcardMatch(const char* pattern, size_t patternLength, const char* text, size_t textLength) {
+    size_t p = 0;
+    size_t t = 0;
+    bool haveStar = false;  // A '*' has been seen
+    size_t star = 0;        // Pattern position after the last '*'
+    size_t resume = 0;      // Text position that '*' currently extends to
+    while (t < textLength) {
+        if (p < patternLength && pattern[p] == '*') {
+            haveStar = true;
+            star = ++p;
+            resume = t;
+        } else if (p < patternLength && (pattern[p] == '?' || pattern[p] == text[t])) {
+            ++p;
+            ++t;
+        } else if (haveStar) {
+            p = star;
+            t = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (p < patternLength && pattern[p] == '*') {
+        ++p;
+    }
+    return p == patternLength;
+}
+
+// Ranking for mostFrequent: more postings first, ties in byte order
+bool moreFrequent(const IndexedToken* a, const IndexedToken* b) {
+    size_t countA = a->getLineNumbers().getSize();
+    size_t countB = b->getLineNumbers().getSize();
+    if (countA != countB) {
+        return countA > countB;
+    }
+    return a->compare(*b) < 0;
+}
+
+// Heap bytes of a token's posting lists (line numbers and document runs)
+size_t postingHeapBytes(const IndexedToken& token) {
+    size_t bytes = token.getLineNumbers().bytesReserved();
+    if (const IntList* runs = token.getDocumentRuns()) {
+        bytes += sizeof(IntList) + runs->bytesReserved();
+    }
+    return bytes;
+}
+
+// Charge a posting list's heap bytes to usage (inline lists live in the node, borrowed ones in the file)
+void addPostings(MemoryUsage& usage, const IntList& list) {
+    size_t reserved = list.bytesReserved();
+    if (reserved > 0) {
+        usage.postings += list.bytesUsed();
+        usage.postingSlack += reserved - list.bytesUsed();
+    }
+}
+
+} // namespace
 
 // Implements: Indexer();
 // Default constructor: Empty sections
-Indexer::Indexer() : sections{}, currentFilename("") {}
+Indexer::Indexer()
+    : sections{}, currentFilename(""), ingestMode(true), dedupLines(false),
+      threadCount(hardwareThreads()), memoryBudget(0), budgetTokens(0), budgetRecheck(0), budgetWarned(false) {}
 
 // Implements: void processToken(const char* text, int lineNumber);
-// processToken: Map to section, update or insert token
+// processToken: Delegate C-string to the view overload
 void Indexer::processToken(const char* text, int lineNumber) {
     if (!text) return;
-    // Determine section (0-25: a-z, 26: non-alpha)
-    int section = 26; // Default to non-alpha
-    char first = std::tolower(text[0]);
-    if (std::isalpha(first)) {
-        section = first - 'a';
+    processToken(text, std::strlen(text), lineNumber);
+}
+
+// Implements: void processToken(const char* text, size_t length, int lineNumber);
+// processToken: Map to section, update or insert token
+void Indexer::processToken(const char* text, size_t length, int lineNumber) {
+    INDEXER_COUNT(tokensProcessed, 1);
+    // An embedded null ends the token, as c_str() did on the stream path
+    const void* nul = std::memchr(text, '\0', length);
+    if (nul) {
+        length = static_cast<size_t>(static_cast<const char*>(nul) - text);
     }
-    // Search for existing token
+    // Fold once here; stored tokens are compared byte for byte from then on
+    if (!normalizer.isIdentity()) {
+        length = normalizer.apply(text, length);
+    }
+    int section = sectionFor(length > 0 ? text[0] : '\0');
     DLList& sec = sections[section];
-    for (size_t i = 0; i < sec.size(); ++i) {
-        IndexedToken& it = sec.getIndexedTokenAt(i);
-        if (it.compare(text) == 0) {
-            it.appendLineNumber(lineNumber);
+    if (ingestMode) {
+        // Find-or-append through the hash table; ordering is deferred
+        SectionState& state = sectionState[section];
+        size_t hash = TokenTable::hash(text, length);
+        IndexedToken* found = state.table.find(text, length, hash);
+        if (found) {
+            INDEXER_COUNT(tokensFound, 1);
+            size_t before = found->getLineNumbers().getSize();
+            appendLine(section, *found, lineNumber);
+            noteFrequency(section, found, before);
             return;
         }
-        if (it.compare(text) > 0) {
-            // Insert before this position to maintain sort
-            sec.addBefore(IndexedToken(text, lineNumber), i);
+        size_t pos = sec.size();
+        if (pos > 0 && sec.getIndexedTokenAt(pos - 1).compare(text, length) > 0) {
+            state.sorted = false;
+        }
+        IndexedToken* added = &sec.emplaceBefore(pos, text, length, lineNumber, arena);
+        INDEXER_COUNT(tokensInserted, 1);
+        state.table.insert(added, hash);
+        addToLengthIndex(section, added);
+        noteFrequency(section, added, 0);
+        return;
+    }
+    // Binary search for existing token or its insertion point
+    ensureSorted(section);
+    size_t pos = sec.lowerBound(text, length);
+    if (pos < sec.size()) {
+        IndexedToken& it = sec.getIndexedTokenAt(pos);
+        if (it.compare(text, length) == 0) {
+            INDEXER_COUNT(tokensFound, 1);
+            size_t before = it.getLineNumbers().getSize();
+            appendLine(section, it, lineNumber);
+            noteFrequency(section, &it, before);
             return;
         }
     }
-    // Append to end if not found
-    sec.addBefore(IndexedToken(text, lineNumber), sec.size());
+    // Insert at pos to maintain sort, building the token in its node
+    IndexedToken* added = &sec.emplaceBefore(pos, text, length, lineNumber, arena);
+    INDEXER_COUNT(tokensInserted, 1);
+    // Keep the table complete so ingest mode can be re-enabled at any time
+    sectionState[section].table.insert(added, TokenTable::hash(text, length));
+    addToLengthIndex(section, added);
+    noteFrequency(section, added, 0);
 }
 
 // Implements: void processToken(Token token, int lineNumber);
@@ -88,27 +498,10 @@ void Indexer::processToken(Token token, int lineNumber) {
     processToken(token.c_str(), lineNumber);
 }
 
-// Implements: void processTextFile(const std::string& filename);
+// Implements: bool processTextFile(const std::string& filename);
 // processTextFile: Read file, tokenize, index tokens
-void Indexer::processTextFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file " << filename << std::endl;
-        return;
-    }
-    clear();
-    currentFilename = filename;
-    std::string line;
-    int lineNumber = 1;
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string word;
-        while (ss >> word) {
-            processToken(word.c_str(), lineNumber);
-        }
-        ++lineNumber;
-    }
-    file.close();
+bool Indexer::processTextFile(const std::string& filename) {
+    return loadTextFile(filename);
 }
 
 // Implements: void clear();
@@ -116,8 +509,21 @@ void Indexer::processTextFile(const std::string& filename) {
 void Indexer::clear() {
     for (int i = 0; i < 27; ++i) {
         sections[i].clear();
+        sectionState[i].table.clear();
+        sectionState[i].sorted = true;
+        sectionState[i].byLength.clear();
+        sectionState[i].frequent.clear();
+        sectionState[i].frequentFloor = 0;
+        sectionState[i].postingBytes = 0;
     }
+    documents.clear();
+    arena.reset();
+    storage.reset();
     currentFilename.clear();
+    follow = FollowState();
+    budgetTokens = 0;
+    budgetRecheck = memoryBudget;
+    budgetWarned = false;
 }
 
 // Implements: bool isEmpty() const;
@@ -134,17 +540,51 @@ bool Indexer::isEmpty() const {
 // Implements: void print(std::ostream& os) const;
 // print: Output all sections
 void Indexer::print(std::ostream& os) const {
+    OutputBuffer out(os);
+    print(out);
+}
+
+// Implements: void print(OutputBuffer& out) const;
+// print: Append all sections to output buffer. Large indexes render each section into its own
+// in-memory buffer on the thread pool, then emit the buffers in section order.
+void Indexer::print(OutputBuffer& out) const {
+    const size_t minParallelTokens = 1 << 14; // Below this, thread start-up outweighs rendering
+    size_t tokens = 0;
     for (int i = 0; i < 27; ++i) {
-        if (!sections[i].isEmpty()) {
-            if (i < 26) {
-                os << "Section " << char('A' + i) << ":\n";
-            } else {
-                os << "Section Non-Alpha:\n";
-            }
-            sections[i].print(os);
-            os << "\n";
+        tokens += sections[i].size();
+    }
+    if (threadCount <= 1 || tokens < minParallelTokens) {
+        for (int i = 0; i < 27; ++i) {
+            printSection(i, out);
         }
+        return;
+    }
+    std::vector<OutputBuffer> rendered(27);
+    parallelFor(27, threadCount, [&](size_t section) {
+        printSection(static_cast<int>(section), rendered[section]);
+    });
+    for (int i = 0; i < 27; ++i) {
+        out.append(rendered[i]);
+        rendered[i] = OutputBuffer(); // Release each section once emitted
+    }
+}
+
+// Implements: void printSection(int section, OutputBuffer& out) const;
+// Private helper: Append one non-empty section with its header (sorts it first if needed)
+void Indexer::printSection(int section, OutputBuffer& out) const {
+    if (sections[section].isEmpty()) {
+        return;
+    }
+    ensureSorted(section);
+    if (section < 26) {
+        out.append("Section ", 8);
+        out.append(char('A' + section));
+        out.append(":\n", 2);
+    } else {
+        out.append("Section Non-Alpha:\n");
     }
+    sections[section].print(out);
+    out.append('\n');
 }
 
 // Implements: void displayAllTokens() const;
@@ -156,38 +596,1228 @@ void Indexer::displayAllTokens() const {
 // Implements: void listByLength(size_t length) const;
 // listByLength: Display tokens of specified length
 void Indexer::listByLength(size_t length) const {
-    bool found = false;
-    for (int i = 0; i < 27; ++i) {
-        for (size_t j = 0; j < sections[i].size(); ++j) {
-            const IndexedToken& it = sections[i].getIndexedTokenAt(j);
-            if (std::strlen(it.getToken().c_str()) == length) {
-                if (!found) {
-                    std::cout << "Tokens of length " << length << ":\n";
-                    found = true;
-                }
-                it.print(std::cout);
-                std::cout << "\n";
-            }
-        }
-    }
-    if (!found) {
+    std::vector<const IndexedToken*> tokens = tokensByLength(length);
+    if (tokens.empty()) {
         std::cout << "No tokens of length " << length << " found.\n";
+        return;
+    }
+    std::cout << "Tokens of length " << length << ":\n";
+    OutputBuffer out(std::cout, 64 * 1024);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        tokens[i]->print(out);
+        out.append('\n');
+    }
+}
+
+// Implements: void listMatching(const std::string& pattern) const;
+// listMatching: Display tokens matching a wildcard pattern ("inter*", "?at")
+void Indexer::listMatching(const std::string& pattern) const {
+    printQueryResult(tokensMatching(pattern), "matching " + pattern);
+}
+
+// Implements: void listRange(const std::string& first, const std::string& last) const;
+// listRange: Display tokens between first and last (inclusive)
+void Indexer::listRange(const std::string& first, const std::string& last) const {
+    printQueryResult(tokensInRange(first, last), "from " + first + " to " + last);
+}
+
+// Implements: static void printQueryResult(const std::vector<const IndexedToken*>& tokens, const std::string& what);
+// Private helper: Display "Tokens <what>:" and one token per line, or "No tokens <what> found."
+void Indexer::printQueryResult(const std::vector<const IndexedToken*>& tokens, const std::string& what) {
+    if (tokens.empty()) {
+        std::cout << "No tokens " << what << " found.\n";
+        return;
+    }
+    std::cout << "Tokens " << what << ":\n";
+    OutputBuffer out(std::cout, 64 * 1024);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        tokens[i]->print(out);
+        out.append('\n');
     }
 }
 
 // Implements: void ViewBySection(char section) const;
 // ViewBySection: Display tokens in specified section
 void Indexer::ViewBySection(char section) const {
-    char sec = std::tolower(section);
-    int index = 26; // Default to non-alpha
-    if (std::isalpha(sec)) {
-        index = sec - 'a';
-    }
+    int index = sectionFor(section);
+    ensureSorted(index);
     if (sections[index].isEmpty()) {
         std::cout << "Section " << (index < 26 ? std::string(1, char('A' + index)) : "Non-Alpha") << " is empty.\n";
     } else {
         std::cout << "Section " << (index < 26 ? std::string(1, char('A' + index)) : "Non-Alpha") << ":\n";
-        sections[index].print(std::cout);
-        std::cout << "\n";
+        OutputBuffer out(std::cout, 64 * 1024);
+        sections[index].print(out);
+        out.append('\n');
+    }
+}
+
+// Implements: static int sectionFor(char first);
+// sectionFor: Map first char to section (0-25: a-z, 26: non-alpha)
+int Indexer::sectionFor(char first) {
+    char lower = std::tolower(first);
+    if (std::isalpha(lower)) {
+        return lower - 'a';
+    }
+    return 26;
+}
+
+// Implements: void ensureSorted(int section) const;
+// ensureSorted: Sort a section once, on first ordered access after appends
+void Indexer::ensureSorted(int section) const {
+    if (!sectionState[section].sorted) {
+        INDEXER_TIMED(sortSection);
+        sections[section].sort();
+        sectionState[section].sorted = true;
+    }
+}
+
+// Implements: void setIngestMode(bool enabled);
+// setIngestMode: Toggle hash interning; leaving ingest mode sorts pending sections
+void Indexer::setIngestMode(bool enabled) {
+    if (!enabled) {
+        for (int i = 0; i < 27; ++i) {
+            ensureSorted(i);
+        }
+    }
+    ingestMode = enabled;
+}
+
+// Implements: bool isIngestMode() const;
+// isIngestMode: Check if ingest mode is on
+bool Indexer::isIngestMode() const {
+    return ingestMode;
+}
+
+// Implements: void addToLengthIndex(int section, const IndexedToken* token);
+// addToLengthIndex: Append to the token's length bucket, flag it if out of order
+void Indexer::addToLengthIndex(int section, const IndexedToken* token) {
+    std::vector<LengthBucket>& buckets = sectionState[section].byLength;
+    size_t length = token->getToken().length();
+    if (length >= buckets.size()) {
+        buckets.resize(length + 1);
+    }
+    LengthBucket& bucket = buckets[length];
+    if (!bucket.tokens.empty() && bucket.tokens.back()->compare(*token) > 0) {
+        bucket.sorted = false;
+    }
+    bucket.tokens.push_back(token);
+}
+
+// Implements: const std::vector<const IndexedToken*>* lengthBucket(int section, size_t length) const;
+// lengthBucket: Return the section's tokens of this length in order, or nullptr if none
+const std::vector<const IndexedToken*>* Indexer::lengthBucket(int section, size_t length) const {
+    std::vector<LengthBucket>& buckets = sectionState[section].byLength;
+    if (length >= buckets.size() || buckets[length].tokens.empty()) {
+        return nullptr;
+    }
+    LengthBucket& bucket = buckets[length];
+    if (!bucket.sorted) {
+        std::sort(bucket.tokens.begin(), bucket.tokens.end(),
+                  [](const IndexedToken* a, const IndexedToken* b) { return a->compare(*b) < 0; });
+        bucket.sorted = true;
+    }
+    return &bucket.tokens;
+}
+
+// Implements: void appendLine(int section, IndexedToken& token, int lineNumber);
+// appendLine: Append line unless dedup is on and the token already ends with it; under a
+// memory budget, add the list's growth (only a full list or a new checkpoint allocates) to the
+// section's postingBytes
+void Indexer::appendLine(int section, IndexedToken& token, int lineNumber) {
+    const IntList& lines = token.getLineNumbers();
+    if (dedupLines && lines.back() == lineNumber) {
+        return;
+    }
+    size_t size = lines.getSize();
+    if (memoryBudget > 0 && (lines.isFull() || IntList::checkpointCount(size + 1) != IntList::checkpointCount(size))) {
+        size_t reserved = lines.bytesReserved();
+        token.appendLineNumber(lineNumber);
+        sectionState[section].postingBytes += lines.bytesReserved() - reserved;
+    } else {
+        token.appendLineNumber(lineNumber);
+    }
+    INDEXER_COUNT(postingsAppended, 1);
+}
+
+// Implements: void noteFrequency(int section, const IndexedToken* token, size_t before);
+// noteFrequency: Called after postings were added to token (before = its count until then).
+// Tokens outside frequent never have more than frequentFloor postings, so only a token that
+// just passed the floor can change the section's top tokens; anything else costs one compare
+void Indexer::noteFrequency(int section, const IndexedToken* token, size_t before) {
+    const SectionState& state = sectionState[section];
+    if (before <= state.frequentFloor && token->getLineNumbers().getSize() > state.frequentFloor) {
+        promoteFrequent(section, token);
+    }
+}
+
+// Implements: void promoteFrequent(int section, const IndexedToken* token);
+// promoteFrequent: Admit token to frequent (evicting the least frequent member if it now has
+// fewer postings), then raise frequentFloor to the least frequent member's count
+void Indexer::promoteFrequent(int section, const IndexedToken* token) {
+    SectionState& state = sectionState[section];
+    std::vector<const IndexedToken*>& frequent = state.frequent;
+    if (frequent.size() < frequentCapacity) {
+        // Not full: every token of the section is a member, so a new one joins
+        if (std::find(frequent.begin(), frequent.end(), token) == frequent.end()) {
+            frequent.push_back(token);
+        }
+        return;
+    }
+    size_t least = 0;
+    bool member = false;
+    for (size_t i = 0; i < frequent.size(); ++i) {
+        member = member || frequent[i] == token;
+        if (frequent[i]->getLineNumbers().getSize() < frequent[least]->getLineNumbers().getSize()) {
+            least = i;
+        }
+    }
+    size_t leastCount = frequent[least]->getLineNumbers().getSize();
+    if (!member && token->getLineNumbers().getSize() > leastCount) {
+        frequent[least] = token;
+    }
+    // The evicted (or passed-over) token is now the largest count outside frequent
+    state.frequentFloor = leastCount;
+}
+
+// Implements: void setDedupLines(bool enabled);
+// setDedupLines: Toggle one posting per (token, line); applies to lines indexed afterwards
+void Indexer::setDedupLines(bool enabled) {
+    dedupLines = enabled;
+}
+
+// Implements: bool isDedupLines() const;
+// isDedupLines: Check if line dedup is on
+bool Indexer::isDedupLines() const {
+    return dedupLines;
+}
+
+// Implements: void setNormalization(unsigned mode);
+// setNormalization: Normalizer flags for tokens indexed afterwards (existing tokens keep their form)
+void Indexer::setNormalization(unsigned mode) {
+    normalizer.setMode(mode);
+}
+
+// Implements: unsigned getNormalization() const;
+// getNormalization: Current Normalizer flags
+unsigned Indexer::getNormalization() const {
+    return normalizer.getMode();
+}
+
+// Implements: bool loadTextFile(const std::string& filename);
+// loadTextFile: Open file (error if unreadable), clear index, index line-aligned chunks
+bool Indexer::loadTextFile(const std::string& filename) {
+    INDEXER_TIMED(indexFile);
+    FileReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return false;
+    }
+    clear();
+    currentFilename = filename;
+    const char* begin;
+    const char* end;
+    int lineNumber = 1;
+    while (reader.nextChunk(begin, end)) {
+        if (reader.isMapped() && threadCount > 1) {
+            indexParallel(begin, end, threadCount);
+        } else {
+            lineNumber = indexRange(begin, end, lineNumber);
+        }
+    }
+    reader.close();
+    checkMemoryBudget();
+    return true;
+}
+
+// Implements: int indexRange(const char* begin, const char* end, int firstLine);
+// indexRange: Tokenize a line-aligned range in batches, index each span, return next line
+int Indexer::indexRange(const char* begin, const char* end, int firstLine) {
+    const size_t batchSize = 256;
+    TokenSpan batch[batchSize];
+    Tokenizer tokenizer(begin, end, firstLine);
+    size_t count;
+    INDEXER_STOPWATCH(watch);
+    while ((count = tokenizer.next(batch, batchSize)) > 0) {
+        INDEXER_LAP(watch, tokenize);
+        for (size_t i = 0; i < count; ++i) {
+            processToken(batch[i].text, batch[i].length, batch[i].line);
+        }
+        INDEXER_LAP(watch, processTokens);
+        if (memoryBudget > 0 && (budgetTokens += count) >= budgetCheckTokens) {
+            checkMemoryBudget();
+        }
+    }
+    INDEXER_LAP(watch, tokenize);
+    return tokenizer.currentLine();
+}
+
+// Implements: void indexParallel(const char* begin, const char* end, unsigned threads);
+// indexParallel: Partial index per newline-aligned chunk, then a per-section parallel merge
+void Indexer::indexParallel(const char* begin, const char* end, unsigned threads) {
+    const size_t minChunkBytes = 1 << 20; // Smaller chunks cost more to merge than to scan
+    size_t bytes = static_cast<size_t>(end - begin);
+    size_t chunks = bytes / minChunkBytes;
+    if (chunks > threads) {
+        chunks = threads;
+    }
+    if (chunks < 2) {
+        indexRange(begin, end, 1);
+        return;
+    }
+    // Chunk k covers [bounds[k], bounds[k + 1]); every boundary follows a newline
+    std::vector<const char*> bounds(chunks + 1);
+    bounds[0] = begin;
+    bounds[chunks] = end;
+    for (size_t k = 1; k < chunks; ++k) {
+        const char* target = begin + bytes / chunks * k;
+        if (target < bounds[k - 1]) {
+            target = bounds[k - 1];
+        }
+        const void* nl = std::memchr(target, '\n', static_cast<size_t>(end - target));
+        bounds[k] = nl ? static_cast<const char*>(nl) + 1 : end;
+    }
+    std::vector<Indexer> partials(chunks);
+    std::vector<int> newlines(chunks);
+    parallelFor(chunks, threads, [&](size_t k) {
+        partials[k].threadCount = 1;
+        partials[k].dedupLines = dedupLines;
+        partials[k].normalizer.setMode(normalizer.getMode());
+        newlines[k] = partials[k].indexRange(bounds[k], bounds[k + 1], 1) - 1;
+    });
+    // Prefix count of newlines gives each chunk's line offset
+    std::vector<int> offsets(chunks);
+    for (size_t k = 1; k < chunks; ++k) {
+        offsets[k] = offsets[k - 1] + newlines[k - 1];
+    }
+    // Partial tokens are arena views; taking the blocks keeps them valid without copying.
+    // Chunks merge in order, each freed before the budget check so the peak shrinks as we go
+    for (size_t k = 0; k < chunks; ++k) {
+        arena.adopt(partials[k].arena);
+        parallelFor(27, threads, [&](size_t section) {
+            mergeSection(static_cast<int>(section), partials[k], offsets[k]);
+        });
+        partials[k] = Indexer();
+        checkMemoryBudget();
+    }
+    if (!ingestMode) {
+        parallelFor(27, threads, [&](size_t section) {
+            ensureSorted(static_cast<int>(section));
+        });
+    }
+}
+
+// Implements: void mergeSection(int section, const Indexer& partial, int lineOffset, int docId = -1);
+// mergeSection: Append partial's lines (offset, tagged with docId if >= 0) to existing tokens,
+// append new tokens at the tail
+void Indexer::mergeSection(int section, const Indexer& partial, int lineOffset, int docId) {
+    INDEXER_TIMED(mergeSections);
+    DLList& sec = sections[section];
+    SectionState& state = sectionState[section];
+    const DLList& source = partial.sections[section];
+    for (const IndexedToken& src : source) {
+        const Token& token = src.getToken();
+        size_t hash = TokenTable::hash(token.c_str(), token.length());
+        IndexedToken* target = state.table.find(token.c_str(), token.length(), hash);
+        size_t before = target ? target->getLineNumbers().getSize() : 0;
+        size_t reserved = (target && memoryBudget > 0) ? postingHeapBytes(*target) : 0;
+        IntList::const_iterator line = src.getLineNumbers().begin();
+        IntList::const_iterator last = src.getLineNumbers().end();
+        if (!target) {
+            size_t pos = sec.size();
+            if (pos > 0 && sec.getIndexedTokenAt(pos - 1).compare(src) > 0) {
+                state.sorted = false;
+            }
+            // The partial's arena was adopted, so the new entry can share its text
+            target = &sec.emplaceBefore(pos, Token::view(token.c_str(), token.length()), *line + lineOffset);
+            if (docId >= 0) {
+                target->assignDocument(docId);
+            }
+            state.table.insert(target, hash);
+            addToLengthIndex(section, target);
+            ++line;
+        }
+        if (docId >= 0) {
+            for (; line != last; ++line) {
+                target->appendPosting(docId, *line + lineOffset);
+            }
+        } else {
+            for (; line != last; ++line) {
+                target->appendLineNumber(*line + lineOffset);
+            }
+        }
+        if (memoryBudget > 0) {
+            state.postingBytes += postingHeapBytes(*target) - reserved;
+        }
+        noteFrequency(section, target, before);
+    }
+}
+
+// Implements: void setThreadCount(unsigned threads);
+// setThreadCount: Threads for parallel ingestion (0 = hardware threads, 1 = sequential)
+void Indexer::setThreadCount(unsigned threads) {
+    threadCount = (threads == 0) ? hardwareThreads() : threads;
+}
+
+// Implements: unsigned getThreadCount() const;
+// getThreadCount: Threads used for parallel ingestion
+unsigned Indexer::getThreadCount() const {
+    return threadCount;
+}
+
+// Implements: void processCorpus(const std::vector<std::string>& filenames);
+// processCorpus: Index files concurrently in batches, docIds in list order, merge by section
+void Indexer::processCorpus(const std::vector<std::string>& filenames) {
+    clear();
+    // Batches bound how many partial indexes are alive at once
+    const size_t batchSize = (threadCount * 4 > 16) ? threadCount * 4 : 16;
+    for (size_t first = 0; first < filenames.size(); first += batchSize) {
+        size_t count = filenames.size() - first;
+        if (count > batchSize) {
+            count = batchSize;
+        }
+        std::vector<Indexer> partials(count);
+        std::vector<char> loaded(count);
+        parallelFor(count, threadCount, [&](size_t i) {
+            partials[i].threadCount = 1;
+            partials[i].dedupLines = dedupLines;
+            partials[i].normalizer.setMode(normalizer.getMode());
+            loaded[i] = partials[i].loadTextFile(filenames[first + i]);
+        });
+        std::vector<int> docIds(count, -1);
+        for (size_t i = 0; i < count; ++i) {
+            if (loaded[i]) {
+                docIds[i] = static_cast<int>(documents.size());
+                documents.push_back(filenames[first + i]);
+                arena.adopt(partials[i].arena);
+            }
+        }
+        parallelFor(27, threadCount, [&](size_t section) {
+            for (size_t i = 0; i < count; ++i) {
+                if (docIds[i] >= 0) {
+                    mergeSection(static_cast<int>(section), partials[i], 0, docIds[i]);
+                }
+            }
+            if (!ingestMode) {
+                ensureSorted(static_cast<int>(section));
+            }
+        });
+        partials.clear();
+        checkMemoryBudget();
+    }
+}
+
+// Implements: int addFile(const std::string& filename);
+// addFile: Index one file on its own and merge it under the next docId
+int Indexer::addFile(const std::string& filename) {
+    Indexer partial;
+    partial.threadCount = threadCount;
+    partial.dedupLines = dedupLines;
+    partial.normalizer.setMode(normalizer.getMode());
+    if (!partial.loadTextFile(filename)) {
+        return -1;
+    }
+    if (documents.empty() && !isEmpty()) {
+        convertToCorpus();
+    }
+    follow = FollowState(); // Corpus postings carry docIds; a followed file's lines would not
+    int docId = static_cast<int>(documents.size());
+    documents.push_back(filename);
+    arena.adopt(partial.arena);
+    parallelFor(27, threadCount, [&](size_t section) {
+        mergeSection(static_cast<int>(section), partial, 0, docId);
+        if (!ingestMode) {
+            ensureSorted(static_cast<int>(section));
+        }
+    });
+    checkMemoryBudget();
+    return docId;
+}
+
+// Implements: void convertToCorpus();
+// convertToCorpus: The file indexed so far becomes document 0
+void Indexer::convertToCorpus() {
+    documents.push_back(currentFilename);
+    for (int i = 0; i < 27; ++i) {
+        for (IndexedToken& token : sections[i]) {
+            token.assignDocument(0);
+        }
+    }
+    recountPostings();
+}
+
+// Implements: bool isCorpus() const;
+// isCorpus: Check if postings carry document ids
+bool Indexer::isCorpus() const {
+    return !documents.empty();
+}
+
+// Implements: size_t documentCount() const;
+// documentCount: Number of corpus documents
+size_t Indexer::documentCount() const {
+    return documents.size();
+}
+
+// Implements: const std::string& documentName(size_t docId) const;
+// documentName: Filename of a document, throw if invalid
+const std::string& Indexer::documentName(size_t docId) const {
+    if (docId >= documents.size()) {
+        throw std::out_of_range("Document id out of range");
+    }
+    return documents[docId];
+}
+
+// Implements: bool save(const std::string& filename) const;
+// save: Write header, section table, dictionary, text, postings and names; false on I/O error
+bool Indexer::save(const std::string& filename) const {
+    INDEXER_TIMED(saveIndex);
+    std::string tempname = filename + ".tmp";
+    std::ofstream out(tempname.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: Cannot write file " << filename << std::endl;
+        return false;
+    }
+    IndexFormat::Header header = IndexFormat::Header();
+    std::memcpy(header.magic, IndexFormat::magic, sizeof(header.magic));
+    header.version = IndexFormat::version;
+    header.endianTag = IndexFormat::endianTag;
+    header.sectionCount = 27;
+    header.flags = (isCorpus() ? IndexFormat::flagCorpus : 0) |
+                   (dedupLines ? IndexFormat::flagDedupLines : 0) |
+                   ((normalizer.getMode() & Normalizer::foldCase) ? IndexFormat::flagFoldCase : 0) |
+                   ((normalizer.getMode() & Normalizer::stripPunctuation) ? IndexFormat::flagStripPunctuation : 0);
+
+    IndexFormat::SectionRef refs[27];
+    uint64_t textSize = 0;
+    for (int i = 0; i < 27; ++i) {
+        ensureSorted(i);
+        refs[i].firstEntry = header.tokenCount;
+        refs[i].entryCount = sections[i].size();
+        header.tokenCount += sections[i].size();
+        for (const IndexedToken& token : sections[i]) {
+            textSize += token.getToken().length() + 1;
+        }
+    }
+    header.sectionsOffset = IndexFormat::align(sizeof(header), 8);
+    header.entriesOffset = header.sectionsOffset + sizeof(refs);
+    header.docRunsOffset = header.entriesOffset + header.tokenCount * sizeof(IndexFormat::Entry);
+    header.textOffset = header.docRunsOffset;
+    if (isCorpus()) {
+        header.textOffset += header.tokenCount * sizeof(IndexFormat::ListRef);
+    }
+    header.postingsOffset = IndexFormat::align(header.textOffset + textSize, 8);
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header)); // Rewritten at the end
+    IndexWriter writer(out);
+    writer.padTo(header.sectionsOffset);
+    writer.write(refs, sizeof(refs));
+
+    // Dictionary and document runs: offsets follow the order of the text and postings regions
+    uint64_t textCursor = 0;
+    uint64_t postingsCursor = 0;
+    for (int i = 0; i < 27; ++i) {
+        for (const IndexedToken& token : sections[i]) {
+            IndexFormat::Entry entry = IndexFormat::Entry();
+            entry.textOffset = textCursor;
+            entry.textLength = static_cast<uint32_t>(token.getToken().length());
+            textCursor += entry.textLength + 1;
+            entry.lines = placeList(token.getLineNumbers(), postingsCursor);
+            writer.write(&entry, sizeof(entry));
+        }
+    }
+    if (isCorpus()) {
+        const IntList none;
+        for (int i = 0; i < 27; ++i) {
+            for (const IndexedToken& token : sections[i]) {
+                const IntList* runs = token.getDocumentRuns();
+                IndexFormat::ListRef ref = placeList(runs ? *runs : none, postingsCursor);
+                writer.write(&ref, sizeof(ref));
+            }
+        }
+    }
+    for (int i = 0; i < 27; ++i) {
+        for (const IndexedToken& token : sections[i]) {
+            writer.write(token.getToken().c_str(), token.getToken().length() + 1);
+        }
+    }
+    writer.padTo(header.postingsOffset);
+    for (int i = 0; i < 27; ++i) {
+        for (const IndexedToken& token : sections[i]) {
+            writeList(writer, token.getLineNumbers());
+        }
+    }
+    for (int i = 0; isCorpus() && i < 27; ++i) {
+        for (const IndexedToken& token : sections[i]) {
+            const IntList* runs = token.getDocumentRuns();
+            if (runs) {
+                writeList(writer, *runs);
+            }
+        }
+    }
+    header.namesOffset = header.postingsOffset + postingsCursor;
+    writer.padTo(header.namesOffset);
+    writeName(writer, currentFilename);
+    uint32_t count = static_cast<uint32_t>(documents.size());
+    writer.write(&count, sizeof(count));
+    for (size_t i = 0; i < documents.size(); ++i) {
+        writeName(writer, documents[i]);
+    }
+    header.fileSize = writer.offset();
+    header.checksum = writer.checksum();
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    // Renaming keeps a currently loaded index file mapped intact
+    if (!out || std::rename(tempname.c_str(), filename.c_str()) != 0) {
+        std::remove(tempname.c_str());
+        std::cerr << "Error: Cannot write file " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Implements: bool load(const std::string& filename, bool verifyChecksum = true);
+// load: Map an index file, validate it, link nodes that view its tokens and postings in place
+bool Indexer::load(const std::string& filename, bool verifyChecksum) {
+    INDEXER_TIMED(loadIndex);
+    std::unique_ptr<FileReader> reader(new FileReader());
+    const char* begin;
+    const char* end;
+    if (!reader->open(filename) || !reader->isMapped() || !reader->nextChunk(begin, end)) {
+        std::cerr << "Error: Cannot open index file " << filename << std::endl;
+        return false;
+    }
+    const unsigned char* base = reinterpret_cast<const unsigned char*>(begin);
+    std::string source;
+    std::vector<std::string> names;
+    const char* problem = checkIndexFile(base, static_cast<size_t>(end - begin), verifyChecksum,
+                                         source, names);
+    if (problem) {
+        std::cerr << "Error: Invalid index file " << filename << " (" << problem << ")" << std::endl;
+        return false;
+    }
+    IndexFormat::Header header;
+    std::memcpy(&header, base, sizeof(header));
+    clear();
+    const char* text = begin + header.textOffset;
+    const unsigned char* postings = base + header.postingsOffset;
+    for (int i = 0; i < 27; ++i) {
+        IndexFormat::SectionRef ref;
+        std::memcpy(&ref, base + header.sectionsOffset + i * sizeof(ref), sizeof(ref));
+        DLList& sec = sections[i];
+        SectionState& state = sectionState[i];
+        state.table.reserve(static_cast<size_t>(ref.entryCount));
+        for (uint64_t k = ref.firstEntry; k < ref.firstEntry + ref.entryCount; ++k) {
+            IndexFormat::Entry entry;
+            std::memcpy(&entry, base + header.entriesOffset + k * sizeof(entry), sizeof(entry));
+            const char* tokenText = text + entry.textOffset;
+            IndexedToken token(Token::view(tokenText, entry.textLength),
+                               borrowList(postings, entry.lines));
+            if (header.flags & IndexFormat::flagCorpus) {
+                IndexFormat::ListRef runs;
+                std::memcpy(&runs, base + header.docRunsOffset + k * sizeof(runs), sizeof(runs));
+                if (runs.count > 0) {
+                    token.setDocumentRuns(borrowList(postings, runs));
+                }
+            }
+            // The dictionary is sorted, so appending keeps the section ordered
+            size_t pos = sec.size();
+            IndexedToken* added = &sec.emplaceBefore(pos, std::move(token));
+            state.table.insert(added, TokenTable::hash(tokenText, entry.textLength));
+            addToLengthIndex(i, added);
+            noteFrequency(i, added, 0);
+        }
+    }
+    currentFilename = source;
+    documents.swap(names);
+    dedupLines = (header.flags & IndexFormat::flagDedupLines) != 0;
+    unsigned mode = Normalizer::none;
+    if (header.flags & IndexFormat::flagFoldCase) {
+        mode |= Normalizer::foldCase;
+    }
+    if (header.flags & IndexFormat::flagStripPunctuation) {
+        mode |= Normalizer::stripPunctuation;
+    }
+    normalizer.setMode(mode);
+    storage = std::move(reader);
+    return true;
+}
+
+// Implements: const IndexedToken* find(const std::string& text) const;
+// find: Exact lookup through the section's TokenTable
+const IndexedToken* Indexer::find(const std::string& text) const {
+    // An embedded null ends the token, as in processToken
+    const char* query = text.c_str();
+    size_t length = std::strlen(query);
+    // Queries are normalized like ingested tokens ("The," finds "the" when folding)
+    Normalizer folding(normalizer.getMode());
+    length = folding.apply(query, length);
+    int section = sectionFor(length > 0 ? query[0] : '\0');
+    return sectionState[section].table.find(query, length, TokenTable::hash(query, length));
+}
+
+// Implements: std::vector<const IndexedToken*> tokensByLength(size_t length) const;
+// tokensByLength: Tokens of length, section by section, sorted within each section
+std::vector<const IndexedToken*> Indexer::tokensByLength(size_t length) const {
+    std::vector<const IndexedToken*> tokens;
+    for (int i = 0; i < 27; ++i) {
+        const std::vector<const IndexedToken*>* bucket = lengthBucket(i, length);
+        if (bucket) {
+            tokens.insert(tokens.end(), bucket->begin(), bucket->end());
+        }
+    }
+    return tokens;
+}
+
+// Implements: std::vector<const IndexedToken*> tokensInSection(char section) const;
+// tokensInSection: Tokens of the section for a letter (anything else: non-alpha), sorted
+std::vector<const IndexedToken*> Indexer::tokensInSection(char section) const {
+    int index = sectionFor(section);
+    ensureSorted(index);
+    const DLList& sec = sections[index];
+    std::vector<const IndexedToken*> tokens;
+    tokens.reserve(sec.size());
+    for (const IndexedToken& token : sec) {
+        tokens.push_back(&token);
+    }
+    return tokens;
+}
+
+// Implements: bool followFile(const std::string& filename);
+// followFile: Clear, index the complete lines of a regular file and remember where they end
+bool Indexer::followFile(const std::string& filename) {
+    INDEXER_TIMED(indexFile);
+    struct stat st;
+    if (::stat(filename.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        std::cerr << "Error: Cannot follow file " << filename << std::endl;
+        return false;
+    }
+    FileReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return false;
+    }
+    clear();
+    currentFilename = filename;
+    follow.filename = filename;
+    follow.device = static_cast<unsigned long long>(st.st_dev);
+    follow.inode = static_cast<unsigned long long>(st.st_ino);
+    const char* begin;
+    const char* end;
+    while (reader.nextChunk(begin, end)) {
+        // Chunks end on line boundaries except at end of file, where a partial line may remain
+        const char* cut = end;
+        while (cut > begin && cut[-1] != '\n') {
+            --cut;
+        }
+        if (cut == begin) {
+            continue;
+        }
+        if (reader.isMapped() && threadCount > 1) {
+            indexParallel(begin, cut, threadCount);
+            follow.nextLine += static_cast<int>(std::count(begin, cut, '\n'));
+        } else {
+            follow.nextLine = indexRange(begin, cut, follow.nextLine);
+        }
+        follow.offset += static_cast<unsigned long long>(cut - begin);
+        rememberTail(begin, static_cast<size_t>(cut - begin));
+    }
+    reader.close();
+    checkMemoryBudget();
+    return true;
+}
+
+// Implements: long refresh();
+// refresh: Index lines appended since the last call (re-follow a replaced file), return lines added
+long Indexer::refresh() {
+    if (follow.filename.empty()) {
+        return -1;
+    }
+    int fd = ::open(follow.filename.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        std::cerr << "Error: Cannot open file " << follow.filename << std::endl;
+        return -1;
+    }
+    unsigned long long size = static_cast<unsigned long long>(st.st_size);
+    if (static_cast<unsigned long long>(st.st_dev) != follow.device ||
+        static_cast<unsigned long long>(st.st_ino) != follow.inode ||
+        size < follow.offset || !tailMatches(fd)) {
+        // Rotated, truncated or rewritten: the index restarts from the file as it is now
+        ::close(fd);
+        std::string filename = follow.filename;
+        return followFile(filename) ? static_cast<long>(follow.nextLine - 1) : -1;
+    }
+    long added = ingestAppended(fd, size);
+    ::close(fd);
+    return added;
+}
+
+// Implements: bool isFollowing() const;
+// isFollowing: Check if refresh has a file to follow
+bool Indexer::isFollowing() const {
+    return !follow.filename.empty();
+}
+
+// Implements: long ingestAppended(int fd, unsigned long long size);
+// Private helper: Read [offset, size) in blocks and index each block's complete lines; a partial
+// line is carried into the next block, and whatever is left at the end waits for the next call
+long Indexer::ingestAppended(int fd, unsigned long long size) {
+    const size_t blockSize = 1 << 22;
+    const int firstLine = follow.nextLine;
+    std::vector<char> buffer;
+    size_t carry = 0; // Bytes of an unfinished line at the front of buffer
+    unsigned long long pos = follow.offset;
+    while (pos < size) {
+        size_t want = (size - pos < blockSize) ? static_cast<size_t>(size - pos) : blockSize;
+        buffer.resize(carry + want);
+        ssize_t got = ::pread(fd, buffer.data() + carry, want, static_cast<off_t>(pos));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            break; // Shrunk since fstat; the next refresh sees the truncation
+        }
+        pos += static_cast<unsigned long long>(got);
+        size_t have = carry + static_cast<size_t>(got);
+        size_t cut = have;
+        while (cut > carry && buffer[cut - 1] != '\n') { // The carried bytes hold no newline
+            --cut;
+        }
+        if (cut > carry) {
+            follow.nextLine = indexRange(buffer.data(), buffer.data() + cut, follow.nextLine);
+            follow.offset += cut;
+            rememberTail(buffer.data(), cut);
+            buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(cut));
+            carry = have - cut;
+        } else {
+            carry = have;
+        }
+    }
+    checkMemoryBudget();
+    return static_cast<long>(follow.nextLine - firstLine);
+}
+
+// Implements: bool tailMatches(int fd) const;
+// Private helper: Check that the bytes just before the offset are still the ones ingested
+bool Indexer::tailMatches(int fd) const {
+    if (follow.tail.empty()) {
+        return true;
+    }
+    std::string current(follow.tail.size(), '\0');
+    off_t at = static_cast<off_t>(follow.offset - follow.tail.size());
+    ssize_t got;
+    do {
+        got = ::pread(fd, &current[0], current.size(), at);
+    } while (got < 0 && errno == EINTR);
+    return got == static_cast<ssize_t>(current.size()) && current == follow.tail;
+}
+
+// Implements: void rememberTail(const char* begin, size_t length);
+// Private helper: Keep the last bytes ingested (up to tailBytes) for tailMatches
+void Indexer::rememberTail(const char* begin, size_t length) {
+    const size_t tailBytes = 64;
+    if (length >= tailBytes) {
+        follow.tail.assign(begin + length - tailBytes, tailBytes);
+        return;
+    }
+    follow.tail.append(begin, length);
+    if (follow.tail.size() > tailBytes) {
+        follow.tail.erase(0, follow.tail.size() - tailBytes);
     }
-}
\ No newline at end of file
+}
+
+// Implements: void collectPrefix(int section, const char* prefix, size_t length, std::vector<const IndexedToken*>& tokens) const;
+// Private helper: Append the section's tokens that start with prefix (a contiguous sorted run)
+void Indexer::collectPrefix(int section, const char* prefix, size_t length,
+                            std::vector<const IndexedToken*>& tokens) const {
+    ensureSorted(section);
+    const DLList& sec = sections[section];
+    for (size_t pos = sec.lowerBound(prefix, length); pos < sec.size(); ++pos) {
+        const IndexedToken& token = sec.getIndexedTokenAt(pos);
+        const Token& text = token.getToken();
+        if (text.length() < length || std::memcmp(text.c_str(), prefix, length) != 0) {
+            break;
+        }
+        tokens.push_back(&token);
+    }
+}
+
+// Implements: std::vector<const IndexedToken*> tokensWithPrefix(const std::string& prefix) const;
+// tokensWithPrefix: Tokens starting with prefix, sorted (every token for an empty prefix)
+std::vector<const IndexedToken*> Indexer::tokensWithPrefix(const std::string& prefix) const {
+    Normalizer folding(normalizer.getMode() & Normalizer::foldCase);
+    const char* text = prefix.c_str();
+    size_t length = folding.apply(text, prefix.size());
+    std::vector<const IndexedToken*> tokens;
+    if (length == 0) {
+        for (int i = 0; i < 27; ++i) {
+            collectPrefix(i, text, 0, tokens);
+        }
+    } else {
+        collectPrefix(sectionFor(text[0]), text, length, tokens);
+    }
+    return tokens;
+}
+
+// Implements: std::vector<const IndexedToken*> tokensInRange(const std::string& first, const std::string& last) const;
+// tokensInRange: Tokens between first and last inclusive (byte order), in display order
+std::vector<const IndexedToken*> Indexer::tokensInRange(const std::string& first, const std::string& last) const {
+    Normalizer foldFirst(normalizer.getMode() & Normalizer::foldCase);
+    Normalizer foldLast(normalizer.getMode() & Normalizer::foldCase);
+    const char* low = first.c_str();
+    size_t lowLength = foldFirst.apply(low, first.size());
+    const char* high = last.c_str();
+    size_t highLength = foldLast.apply(high, last.size());
+    std::vector<const IndexedToken*> tokens;
+    for (int i = 0; i < 27; ++i) {
+        const DLList& sec = sections[i];
+        if (sec.isEmpty()) {
+            continue;
+        }
+        ensureSorted(i);
+        for (size_t pos = sec.lowerBound(low, lowLength); pos < sec.size(); ++pos) {
+            const IndexedToken& token = sec.getIndexedTokenAt(pos);
+            if (token.compare(high, highLength) > 0) {
+                break;
+            }
+            tokens.push_back(&token);
+        }
+    }
+    return tokens;
+}
+
+// Implements: std::vector<const IndexedToken*> tokensMatching(const std::string& pattern) const;
+// tokensMatching: Tokens matching a '*' / '?' pattern, seeking to its literal prefix
+std::vector<const IndexedToken*> Indexer::tokensMatching(const std::string& pattern) const {
+    Normalizer folding(normalizer.getMode() & Normalizer::foldCase);
+    const char* text = pattern.c_str();
+    size_t length = folding.apply(text, pattern.size());
+    size_t literal = 0;
+    while (literal < length && text[literal] != '*' && text[literal] != '?') {
+        ++literal;
+    }
+    std::vector<const IndexedToken*> candidates;
+    if (literal > 0) {
+        collectPrefix(sectionFor(text[0]), text, literal, candidates);
+    } else {
+        for (int i = 0; i < 27; ++i) {
+            collectPrefix(i, text, 0, candidates);
+        }
+    }
+    if (literal + 1 == length && text[literal] == '*') {
+        return candidates; // Plain prefix query
+    }
+    std::vector<const IndexedToken*> tokens;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const Token& token = candidates[i]->getToken();
+        if (wildcardMatch(text + literal, length - literal, token.c_str() + literal, token.length() - literal)) {
+            tokens.push_back(candidates[i]);
+        }
+    }
+    return tokens;
+}
+
+// Implements: std::vector<LineHit> linesMatching(const std::string& expression) const;
+// linesMatching: Lines satisfying a Boolean query, throw std::invalid_argument if malformed
+std::vector<LineHit> Indexer::linesMatching(const std::string& expression) const {
+    return Query::evaluate(*this, expression);
+}
+
+// Implements: void listQuery(const std::string& expression) const;
+// listQuery: Display "Lines matching <expression>: ..." or "No lines match <expression>."
+void Indexer::listQuery(const std::string& expression) const {
+    std::vector<LineHit> hits = linesMatching(expression);
+    if (hits.empty()) {
+        std::cout << "No lines match " << expression << ".\n";
+        return;
+    }
+    std::cout << "Lines matching " << expression << ":\n";
+    OutputBuffer out(std::cout, 64 * 1024);
+    for (size_t i = 0; i < hits.size(); ++i) {
+        if (i > 0) {
+            out.append(' ');
+        }
+        if (isCorpus()) {
+            out.appendInt(hits[i].docId);
+            out.append(':');
+        }
+        out.appendInt(hits[i].line);
+    }
+    out.append('\n');
+}
+
+// Implements: std::vector<const IndexedToken*> mostFrequentIn(size_t k, int first, int last) const;
+// mostFrequentIn: Top k tokens of sections first..last from the tracked candidates, reading a
+// section in full only where an untracked token could still rank
+std::vector<const IndexedToken*> Indexer::mostFrequentIn(size_t k, int first, int last) const {
+    std::vector<const IndexedToken*> tokens;
+    if (k == 0) {
+        return tokens;
+    }
+    for (int i = first; i <= last; ++i) {
+        tokens.insert(tokens.end(), sectionState[i].frequent.begin(), sectionState[i].frequent.end());
+    }
+    // Untracked tokens have at most frequentFloor postings; they matter only if that reaches
+    // the k-th tracked count (or there are not k tracked tokens to choose from)
+    size_t kthCount = 0;
+    if (k <= frequentCapacity && tokens.size() >= k) {
+        std::nth_element(tokens.begin(), tokens.begin() + (k - 1), tokens.end(), moreFrequent);
+        kthCount = tokens[k - 1]->getLineNumbers().getSize();
+    }
+    auto readInFull = [&](int i) {
+        const SectionState& state = sectionState[i];
+        return sections[i].size() > state.frequent.size() &&
+               (k > frequentCapacity || kthCount == 0 || state.frequentFloor >= kthCount);
+    };
+    bool complete = true;
+    for (int i = first; i <= last; ++i) {
+        complete = complete && !readInFull(i);
+    }
+    if (!complete) {
+        tokens.clear();
+        for (int i = first; i <= last; ++i) {
+            if (readInFull(i)) {
+                for (const IndexedToken& token : sections[i]) {
+                    tokens.push_back(&token);
+                }
+            } else {
+                tokens.insert(tokens.end(), sectionState[i].frequent.begin(), sectionState[i].frequent.end());
+            }
+        }
+    }
+    size_t count = tokens.size() < k ? tokens.size() : k;
+    std::partial_sort(tokens.begin(), tokens.begin() + count, tokens.end(), moreFrequent);
+    tokens.resize(count);
+    return tokens;
+}
+
+// Implements: std::vector<const IndexedToken*> mostFrequent(size_t k) const;
+// mostFrequent: The k tokens with the most postings across all sections, most frequent first
+std::vector<const IndexedToken*> Indexer::mostFrequent(size_t k) const {
+    return mostFrequentIn(k, 0, 26);
+}
+
+// Implements: std::vector<const IndexedToken*> mostFrequent(size_t k, char section) const;
+// mostFrequent: The k most frequent tokens of the section for a letter (anything else: non-alpha)
+std::vector<const IndexedToken*> Indexer::mostFrequent(size_t k, char section) const {
+    int index = sectionFor(section);
+    return mostFrequentIn(k, index, index);
+}
+
+// Implements: static void printFrequent(const std::vector<const IndexedToken*>& tokens, const std::string& what);
+// printFrequent: Display one "count token" line per token
+void Indexer::printFrequent(const std::vector<const IndexedToken*>& tokens, const std::string& what) {
+    if (tokens.empty()) {
+        std::cout << "No tokens " << what << " found.\n";
+        return;
+    }
+    std::cout << "Most frequent tokens " << what << ":\n";
+    OutputBuffer out(std::cout, 64 * 1024);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        out.appendInt(static_cast<long long>(tokens[i]->getLineNumbers().getSize()));
+        out.append(' ');
+        out.append(tokens[i]->getToken().c_str(), tokens[i]->getToken().length());
+        out.append('\n');
+    }
+}
+
+// Implements: void listMostFrequent(size_t k) const;
+// listMostFrequent: Display the k most frequent tokens of the index
+void Indexer::listMostFrequent(size_t k) const {
+    printFrequent(mostFrequent(k), "in all sections");
+}
+
+// Implements: void listMostFrequent(size_t k, char section) const;
+// listMostFrequent: Display the k most frequent tokens of one section
+void Indexer::listMostFrequent(size_t k, char section) const {
+    int index = sectionFor(section);
+    printFrequent(mostFrequent(k, section),
+                  "in section " + (index < 26 ? std::string(1, char('A' + index)) : std::string("Non-Alpha")));
+}
+
+// Implements: size_t heapBytes() const;
+// heapBytes: Sum of everything but the mapped file
+size_t MemoryUsage::heapBytes() const {
+    return tokenText + nodes + postings + postingSlack + lookup + allocatorSlack;
+}
+
+// Implements: size_t total() const;
+// total: Heap bytes plus the mapped file
+size_t MemoryUsage::total() const {
+    return heapBytes() + mapped;
+}
+
+// Implements: MemoryUsage& operator+=(const MemoryUsage& other);
+// operator+=: Add other field by field
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other) {
+    tokenText += other.tokenText;
+    nodes += other.nodes;
+    postings += other.postings;
+    postingSlack += other.postingSlack;
+    lookup += other.lookup;
+    allocatorSlack += other.allocatorSlack;
+    mapped += other.mapped;
+    return *this;
+}
+
+// Implements: MemoryReport memoryUsage() const;
+// memoryUsage: Add up what each section holds, by kind, then what the sections share
+MemoryReport Indexer::memoryUsage() const {
+    MemoryReport report;
+    size_t arenaText = 0;
+    for (int i = 0; i < 27; ++i) {
+        MemoryUsage& usage = report.sections[i];
+        for (const IndexedToken& token : sections[i]) {
+            const Token& text = token.getToken();
+            if (!storage || !storage->contains(text.c_str())) {
+                usage.tokenText += text.length() + 1;
+                if (!text.isOwned()) {
+                    arenaText += text.length() + 1;
+                }
+            }
+            addPostings(usage, token.getLineNumbers());
+            if (const IntList* runs = token.getDocumentRuns()) {
+                usage.postings += sizeof(IntList);
+                addPostings(usage, *runs);
+            }
+        }
+        usage.nodes = sections[i].bytesUsed();
+        usage.allocatorSlack = sections[i].bytesReserved() - usage.nodes;
+        const SectionState& state = sectionState[i];
+        usage.lookup = state.table.bytesReserved() + state.byLength.capacity() * sizeof(LengthBucket) +
+                       state.frequent.capacity() * sizeof(const IndexedToken*);
+        for (const LengthBucket& bucket : state.byLength) {
+            usage.lookup += bucket.tokens.capacity() * sizeof(const IndexedToken*);
+        }
+        report.total += usage;
+    }
+    report.shared.allocatorSlack = arena.bytesReserved() > arenaText ? arena.bytesReserved() - arenaText : 0;
+    report.shared.mapped = storage ? storage->mappedLength() : 0;
+    report.total += report.shared;
+    return report;
+}
+
+// Implements: void listMemoryUsage() const;
+// listMemoryUsage: One row per non-empty section, then shared bytes and totals
+void Indexer::listMemoryUsage() const {
+    MemoryReport report = memoryUsage();
+    std::ios::fmtflags flags = std::cout.flags();
+    std::cout << "\nMemory usage (bytes):\n" << std::left << std::setw(10) << "Section" << std::right
+              << std::setw(12) << "Text" << std::setw(12) << "Nodes" << std::setw(12) << "Postings"
+              << std::setw(12) << "Slack" << std::setw(12) << "Lookup" << std::setw(12) << "Allocator"
+              << std::setw(12) << "Total" << "\n";
+    for (int i = 0; i <= 28; ++i) {
+        const MemoryUsage& usage = (i < 27) ? report.sections[i] : (i == 27 ? report.shared : report.total);
+        if (i < 27 && sections[i].isEmpty() && usage.heapBytes() == 0) {
+            continue;
+        }
+        std::string label = (i < 26) ? std::string(1, char('A' + i))
+                          : (i == 26 ? "Non-Alpha" : (i == 27 ? "Shared" : "Total"));
+        std::cout << std::left << std::setw(10) << label << std::right << std::setw(12) << usage.tokenText
+                  << std::setw(12) << usage.nodes << std::setw(12) << usage.postings
+                  << std::setw(12) << usage.postingSlack << std::setw(12) << usage.lookup
+                  << std::setw(12) << usage.allocatorSlack << std::setw(12) << usage.heapBytes() << "\n";
+    }
+    std::cout.flags(flags);
+    if (report.total.mapped > 0) {
+        std::cout << "Mapped index file: " << report.total.mapped << " bytes (file-backed, not in Total)\n";
+    }
+    if (memoryBudget > 0) {
+        std::cout << "Memory budget: " << memoryBudget << " bytes\n";
+    }
+}
+
+// Implements: void compact();
+// compact: Trim every posting list, list index and length bucket, release spare arena blocks
+void Indexer::compact() {
+    for (int i = 0; i < 27; ++i) {
+        for (IndexedToken& token : sections[i]) {
+            token.shrinkToFit();
+        }
+        sections[i].shrinkToFit();
+        for (LengthBucket& bucket : sectionState[i].byLength) {
+            bucket.tokens.shrink_to_fit();
+        }
+        sectionState[i].byLength.shrink_to_fit();
+    }
+    arena.releaseSpare();
+    recountPostings();
+}
+
+// Implements: void setMemoryBudget(size_t bytes);
+// setMemoryBudget: Set the heap bytes allowed before compaction (0 turns checks off), check now
+void Indexer::setMemoryBudget(size_t bytes) {
+    memoryBudget = bytes;
+    budgetRecheck = bytes;
+    budgetWarned = false;
+    recountPostings();
+    checkMemoryBudget();
+}
+
+// Implements: size_t getMemoryBudget() const;
+// getMemoryBudget: Return memoryBudget
+size_t Indexer::getMemoryBudget() const {
+    return memoryBudget;
+}
+
+// Implements: void checkMemoryBudget();
+// Private helper: Once the estimate passes the budget, measure exactly; over budget, compact when
+// enough posting slack would be freed, and if usage stays over, warn once until it drops back under
+void Indexer::checkMemoryBudget() {
+    budgetTokens = 0;
+    if (memoryBudget == 0) {
+        return;
+    }
+    size_t estimate = estimatedHeapBytes();
+    if (estimate <= budgetRecheck) {
+        if (estimate <= memoryBudget) {
+            budgetWarned = false;
+        }
+        return;
+    }
+    MemoryUsage usage = memoryUsage().total;
+    if (usage.heapBytes() > memoryBudget && usage.postingSlack >= usage.heapBytes() / 16) {
+        compact();
+        usage = memoryUsage().total;
+    }
+    if (usage.heapBytes() <= memoryBudget) {
+        budgetWarned = false;
+    } else if (!budgetWarned) {
+        budgetWarned = true;
+        const size_t megabyte = 1024 * 1024;
+        std::cerr << "Warning: Index holds " << (usage.heapBytes() + megabyte - 1) / megabyte
+                  << " MB, over the memory budget of " << memoryBudget / megabyte << " MB" << std::endl;
+    }
+    estimate = estimatedHeapBytes();
+    budgetRecheck = std::max(memoryBudget, estimate + estimate / 8);
+}
+
+// Implements: size_t estimatedHeapBytes() const;
+// Private helper: Arena, pools, tables, one length-bucket entry per token and postingBytes; what
+// only a token walk finds (heap-owned token text, vector slack) is left to memoryUsage
+size_t Indexer::estimatedHeapBytes() const {
+    size_t bytes = arena.bytesReserved();
+    for (int i = 0; i < 27; ++i) {
+        const SectionState& state = sectionState[i];
+        bytes += sections[i].bytesReserved() + state.table.bytesReserved() + state.postingBytes +
+                 sections[i].size() * sizeof(const IndexedToken*);
+    }
+    return bytes;
+}
+
+// Implements: void recountPostings();
+// Private helper: Reset each section's postingBytes from its tokens (only kept under a budget)
+void Indexer::recountPostings() {
+    for (int i = 0; i < 27; ++i) {
+        size_t bytes = 0;
+        if (memoryBudget > 0) {
+            for (const IndexedToken& token : sections[i]) {
+                bytes += postingHeapBytes(token);
+            }
+        }
+        sectionState[i].postingBytes = bytes;
+    }
+}
@@ -11,8 +11,28 @@
 //    - Include IndexedToken.h and Token.h for token processing.
 
 // 3. Declare Indexer class
-//    - Define private members: sections (DLList[27]), currentFilename (std::string).
-//    - Declare private methods: processToken (const char*, int), processToken (Token, int).
+//    - Define private members: arena (Arena) owning all token bytes, sections (DLList[27]), currentFilename (std::string).
+//    - Define private members: sectionState (SectionState[27]) with a TokenTable, sorted flag and
+//      length buckets (tokens grouped by length, each bucket sorted lazily), ingestMode (bool),
+//      dedupLines (bool), threadCount (unsigned), documents (std::vector<std::string>, corpus mode),
+//      normalizer (Normalizer) applied to every token before lookup.
+//    - SectionState also tracks the section's most frequent tokens (frequent, at most
+//      frequentCapacity) and frequentFloor, an upper bound on the posting count of every other token.
+//    - Define private member storage (FileReader) holding a loaded index file mapped in memory;
+//      loaded tokens and postings point into it, so it is declared before sections.
+//    - Declare private methods: processToken (const char*, int), processToken (Token, int),
+//      processToken (const char*, size_t, int) for zero-copy views.
+//    - Declare private helpers: sectionFor, ensureSorted, addToLengthIndex, lengthBucket, appendLine,
+//      printSection (one section with its header, used by sequential and parallel print).
+//    - Declare private ingestion helpers: loadTextFile (open, clear, index), indexRange (sequential),
+//      indexParallel (chunked, per-thread partial indexes), mergeSection (fold one section of a
+//      partial index into this one, optionally tagging postings with a docId), convertToCorpus.
+//    - Define private member follow (FollowState): followed file, its identity, byte offset and
+//      next line number, plus the last bytes ingested; helpers ingestAppended, tailMatches, rememberTail.
+//    - Declare private frequency helpers: noteFrequency / promoteFrequent (called wherever postings are
+//      added), mostFrequentIn and printFrequent.
+//    - Define private members memoryBudget, budgetTokens, budgetRecheck and budgetWarned, plus a
+//      running postingBytes per section; helpers checkMemoryBudget, estimatedHeapBytes, recountPostings.
 
 // 4. Declare constructors
 //    - Default constructor: Initialize 27 empty sections.
@@ -27,13 +47,35 @@
 //    - Move assignment: Defaulted (noexcept).
 
 // 7. Declare public methods
-//    - processTextFile: Read and index tokens from file.
-//    - clear: Empty all sections.
+//    - processTextFile: Read and index tokens from file, false if it cannot be opened.
+//    - clear: Empty all sections and rewind the arena.
 //    - isEmpty (const): Check if index is empty.
-//    - print (const): Output entire index to ostream.
+//    - print (const): Output entire index to ostream, or to an OutputBuffer (fast path).
 //    - displayAllTokens (const): Call print(std::cout).
 //    - listByLength (const): Display tokens of specified length.
 //    - ViewBySection (const): Display tokens in specified section.
+//    - setIngestMode / isIngestMode: Toggle hash interning with deferred per-section sort.
+//    - setDedupLines / isDedupLines: Record a line only once per token when enabled.
+//    - setNormalization / getNormalization: Normalizer flags (case folding, edge punctuation).
+//    - setThreadCount / getThreadCount: Worker threads for large mapped files (0 = hardware threads).
+//    - processCorpus: Index many files concurrently into one index with (docId, line) postings.
+//    - addFile: Incrementally add one file to the corpus, returning its docId.
+//    - isCorpus / documentCount / documentName (const): Inspect the corpus documents.
+//    - find / tokensByLength / tokensInSection (const): Query API returning tokens instead of printing.
+//    - tokensWithPrefix / tokensInRange / tokensMatching (const): Ordered queries answered by seeking
+//      into each sorted section; listMatching / listRange display them.
+//    - linesMatching (const): Boolean AND / OR / NOT query over line postings (see Query.h);
+//      listQuery displays the matching lines.
+//    - save (const): Write the index in the IndexFormat layout.
+//    - load: Map an index file and use its tokens and postings in place (copied only when changed).
+//    - followFile / refresh / isFollowing: Tail mode for growing files; refresh costs O(new bytes).
+//    - mostFrequent (const): Top k tokens by posting count, overall or in one section, answered from
+//      the tracked candidates; listMostFrequent displays them.
+//    - memoryUsage (const): MemoryReport (declared before the class) of the bytes held per section:
+//      token text, nodes, postings and their slack, lookup structures, allocator slack; listMemoryUsage
+//      displays it.
+//    - compact: Shrink posting lists and indexes to fit. setMemoryBudget / getMemoryBudget: compact
+//      automatically while indexing once usage passes the budget, and warn if that is not enough.
 
 // 8. Close include guard
 
@@ -42,16 +84,118 @@
 
 #include <string>
 #include <ostream>
+#include <vector>
+#include <memory>
 #include "DLList.h"
 #include "IndexedToken.h"
 #include "Token.h"
+#include "TokenTable.h"
+#include "Arena.h"
+#include "FileReader.h"
+#include "OutputBuffer.h"
+#include "Normalizer.h"
+#include "Query.h"
+
+// Bytes held by one part of the index (see Indexer::memoryUsage)
+struct MemoryUsage {
+    size_t tokenText;       // Token bytes in the arena or on the heap, terminators included
+    size_t nodes;           // List nodes (token, posting and link fields) and their positional index
+    size_t postings;        // Heap posting bytes in use (encoded lines, checkpoints, document runs)
+    size_t postingSlack;    // Heap posting bytes allocated but unused (IntList capacity doubling)
+    size_t lookup;          // Hash table, length buckets and most-frequent candidates
+    size_t allocatorSlack;  // Unused node-pool slots, arena bytes not holding a live token
+    size_t mapped;          // Loaded index file (file-backed pages the system can drop)
+    MemoryUsage()
+        : tokenText(0), nodes(0), postings(0), postingSlack(0), lookup(0), allocatorSlack(0), mapped(0) {}
+    size_t heapBytes() const;   // Everything but mapped
+    size_t total() const;       // heapBytes() + mapped
+    MemoryUsage& operator+=(const MemoryUsage& other);
+};
+
+// Memory of a whole index, by section
+struct MemoryReport {
+    MemoryUsage sections[27];   // 0-25: a-z, 26: non-alpha
+    MemoryUsage shared;         // Not tied to a section: arena slack, mapped index file
+    MemoryUsage total;          // Sum of sections and shared
+};
 
 class Indexer {
 private:
-    DLList sections[27];            // 27 sections (0-25: a-z, 26: non-alpha)
+    // Tokens of one length within a section, kept in section order once sorted
+    struct LengthBucket {
+        std::vector<const IndexedToken*> tokens;
+        bool sorted;                // False while appended tokens await sorting
+        LengthBucket() : sorted(true) {}
+    };
+
+    // Per-section lookup state kept alongside each DLList
+    struct SectionState {
+        TokenTable table;           // Interned tokens of the section (ingest mode)
+        mutable bool sorted;        // False while appended tokens await sorting
+        mutable std::vector<LengthBucket> byLength; // Secondary index: bucket per token length
+        std::vector<const IndexedToken*> frequent; // Most frequent tokens (at most frequentCapacity, unordered)
+        size_t frequentFloor;       // No token outside frequent has more postings than this
+        size_t postingBytes;        // Heap bytes of posting lists (kept only while a budget is set)
+        SectionState() : sorted(true), frequentFloor(0), postingBytes(0) {}
+    };
+
+    // Position reached in a followed file (tail mode)
+    struct FollowState {
+        std::string filename;       // Followed file (empty when not following)
+        unsigned long long device;  // Identity of the ingested file, to detect rotation
+        unsigned long long inode;
+        unsigned long long offset;  // Bytes ingested, always just past a newline
+        int nextLine;               // Line number of the byte at offset
+        std::string tail;           // Last bytes before offset, to detect rewrites in place
+        FollowState() : device(0), inode(0), offset(0), nextLine(1) {}
+    };
+
+    static const size_t frequentCapacity = 64; // Tokens tracked per section for mostFrequent
+    static const size_t budgetCheckTokens = 1 << 16; // Tokens indexed between memory budget checks
+
+    Arena arena;                    // Token bytes for all sections (declared first, destroyed last)
+    std::unique_ptr<FileReader> storage; // Mapped index file behind loaded tokens (nullptr if none)
+    // Sorting a section only reorders it, so ordered access may sort from const methods
+    mutable DLList sections[27];    // 27 sections (0-25: a-z, 26: non-alpha)
+    SectionState sectionState[27];  // Lookup state for each section
     std::string currentFilename;    // Name of indexed file
+    bool ingestMode;                // Hash interning + deferred sort when true
+    bool dedupLines;                // Skip repeated line numbers for a token when true
+    unsigned threadCount;           // Worker threads for parallel ingestion (1 = sequential)
+    std::vector<std::string> documents; // Corpus documents by docId (empty outside corpus mode)
+    FollowState follow;             // Followed file position (tail mode)
+    Normalizer normalizer;          // Folds each token once before lookup (identity by default)
+    size_t memoryBudget;            // Heap bytes before compaction and a warning (0 = no budget)
+    size_t budgetTokens;            // Tokens indexed since the last budget check
+    size_t budgetRecheck;           // Estimate above which the next check measures exactly
+    bool budgetWarned;              // Over-budget warning already given
     void processToken(const char* text, int lineNumber); // Process C-string token
     void processToken(Token token, int lineNumber);      // Process Token object
+    void processToken(const char* text, size_t length, int lineNumber); // Process token view
+    static int sectionFor(char first);                   // Map first char to section index
+    void ensureSorted(int section) const;                // Sort section if tokens were appended
+    void addToLengthIndex(int section, const IndexedToken* token); // Record a new token in its length bucket
+    const std::vector<const IndexedToken*>* lengthBucket(int section, size_t length) const; // Sorted bucket or nullptr
+    void appendLine(int section, IndexedToken& token, int lineNumber); // Append line, honoring dedupLines
+    void noteFrequency(int section, const IndexedToken* token, size_t before); // Track a token that had before postings
+    void promoteFrequent(int section, const IndexedToken* token); // Slow path: token passed the section's floor
+    std::vector<const IndexedToken*> mostFrequentIn(size_t k, int first, int last) const; // Top k of sections [first, last]
+    static void printFrequent(const std::vector<const IndexedToken*>& tokens, const std::string& what); // Display counts
+    bool loadTextFile(const std::string& filename); // Open, clear and index one file, false if unreadable
+    int indexRange(const char* begin, const char* end, int firstLine); // Tokenize and index, return next line
+    void indexParallel(const char* begin, const char* end, unsigned threads); // Chunked multi-threaded ingest
+    void mergeSection(int section, const Indexer& partial, int lineOffset, int docId = -1); // Fold partial's section in
+    void convertToCorpus();                              // Make the current file document 0
+    void printSection(int section, OutputBuffer& out) const; // Append one section with its header
+    long ingestAppended(int fd, unsigned long long size); // Index complete lines in [follow.offset, size)
+    bool tailMatches(int fd) const;                      // Bytes before follow.offset are unchanged
+    void rememberTail(const char* begin, size_t length); // Record the last bytes ingested
+    void collectPrefix(int section, const char* prefix, size_t length,
+                       std::vector<const IndexedToken*>& tokens) const; // Append a section's prefix run
+    static void printQueryResult(const std::vector<const IndexedToken*>& tokens, const std::string& what); // Display query results
+    void checkMemoryBudget();                            // Compact (and warn) if over memoryBudget
+    size_t estimatedHeapBytes() const;                   // Heap bytes without walking the tokens
+    void recountPostings();                              // Recompute each section's postingBytes
 
 public:
 
@@ -68,13 +212,51 @@ public:
     Indexer& operator=(Indexer&& other) noexcept = default; // Move assignment: Defaulted
 
     // Public methods
-    void processTextFile(const std::string& filename);  // Read and index file
+    bool processTextFile(const std::string& filename);  // Read and index file, false if unreadable
     void clear();                           // Clear all sections
     bool isEmpty() const;                   // Check if index is empty
     void print(std::ostream& os) const;    // Output entire index
+    void print(OutputBuffer& out) const;   // Append entire index to output buffer
     void displayAllTokens() const;          // Print to std::cout
     void listByLength(size_t length) const; // Display tokens by length
     void ViewBySection(char section) const; // Display section by letter
+    void listMatching(const std::string& pattern) const; // Display tokens matching a wildcard pattern
+    void listRange(const std::string& first, const std::string& last) const; // Display tokens in a range
+    void listQuery(const std::string& expression) const; // Display lines matching a Boolean query
+    void listMostFrequent(size_t k) const;  // Display the k most frequent tokens with their counts
+    void listMostFrequent(size_t k, char section) const; // Same, within one section
+    void setIngestMode(bool enabled);       // Toggle hash interning (sorts pending sections when disabled)
+    bool isIngestMode() const;              // Check if ingest mode is on
+    void setDedupLines(bool enabled);       // Toggle one posting per (token, line)
+    bool isDedupLines() const;              // Check if line dedup is on
+    void setNormalization(unsigned mode);   // Normalizer flags for tokens indexed afterwards
+    unsigned getNormalization() const;      // Current Normalizer flags
+    void setThreadCount(unsigned threads);  // Threads for parallel ingestion (0 = hardware threads)
+    unsigned getThreadCount() const;        // Threads used for parallel ingestion
+    void processCorpus(const std::vector<std::string>& filenames); // Index files as one corpus
+    int addFile(const std::string& filename); // Add one file to the corpus, return docId (-1 on error)
+    bool isCorpus() const;                  // Check if postings carry document ids
+    size_t documentCount() const;           // Number of corpus documents
+    const std::string& documentName(size_t docId) const; // Filename of a document, throw if invalid
+    const IndexedToken* find(const std::string& text) const; // Token with exactly this text, nullptr if absent
+    std::vector<const IndexedToken*> tokensByLength(size_t length) const; // Tokens of length, in display order
+    std::vector<const IndexedToken*> tokensInSection(char section) const; // Tokens of a section, sorted
+    std::vector<const IndexedToken*> tokensWithPrefix(const std::string& prefix) const; // Tokens starting with prefix
+    std::vector<const IndexedToken*> tokensInRange(const std::string& first, const std::string& last) const; // first <= token <= last
+    std::vector<const IndexedToken*> tokensMatching(const std::string& pattern) const; // '*' / '?' wildcard match
+    std::vector<LineHit> linesMatching(const std::string& expression) const; // Boolean query, throw if malformed
+    std::vector<const IndexedToken*> mostFrequent(size_t k) const; // k tokens with most postings, most first
+    std::vector<const IndexedToken*> mostFrequent(size_t k, char section) const; // Same, within one section
+    bool save(const std::string& filename) const; // Write index file, false on I/O error
+    bool load(const std::string& filename, bool verifyChecksum = true); // Map index file, false if invalid
+    bool followFile(const std::string& filename); // Index complete lines and follow the file, false if unreadable
+    long refresh();                         // Index appended lines (re-follow if rotated), return lines added, -1 on error
+    bool isFollowing() const;               // Check if a file is being followed
+    MemoryReport memoryUsage() const;       // Bytes held, per section and by kind
+    void listMemoryUsage() const;           // Display memoryUsage as a table
+    void compact();                         // Trim posting lists and indexes to their contents
+    void setMemoryBudget(size_t bytes);     // Compact past this many heap bytes, warn if still over (0 = off)
+    size_t getMemoryBudget() const;         // Current memory budget
 };
 
 #endif // INDEXER_H
\ No newline at end of file
@@ -0,0 +1,391 @@
+#include "IndexerCLI.h"
+#include "Instrument.h"
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+IndexerCLI::IndexerCLI() : verifyChecksum(true), pos(0), out(STDOUT_FILENO) {}
+
+int IndexerCLI::run(int argc, char* argv[]) {
+    args.assign(argv + 1, argv + argc);
+    pos = 0;
+    // Options come before the first command
+    while (pos < args.size() && args[pos].compare(0, 2, "--") == 0) {
+        const std::string option = args[pos++];
+        size_t threads = 0;
+        size_t megabytes = 0;
+        if (option == "--threads" && pos < args.size() && parseNumber(args[pos], threads)) {
+            index.setThreadCount(static_cast<unsigned>(threads));
+            ++pos;
+        } else if (option == "--memory-budget" && pos < args.size() && parseNumber(args[pos], megabytes)) {
+            if (megabytes > (SIZE_MAX >> 20)) {
+                std::cerr << "Error: Memory budget " << args[pos] << " MB is too large\n";
+                return 1;
+            }
+            index.setMemoryBudget(megabytes << 20);
+            ++pos;
+        } else if (option == "--dedup") {
+            index.setDedupLines(true);
+        } else if (option == "--fold-case") {
+            index.setNormalization(index.getNormalization() | Normalizer::foldCase);
+        } else if (option == "--strip-punct") {
+            index.setNormalization(index.getNormalization() | Normalizer::stripPunctuation);
+        } else if (option == "--no-verify") {
+            verifyChecksum = false;
+        } else if (option == "--help") {
+            printUsage(std::cout);
+            return 0;
+        } else {
+            std::cerr << "Error: Unknown option " << option << "\n";
+            printUsage(std::cerr);
+            return 1;
+        }
+    }
+    if (pos == args.size()) {
+        printUsage(std::cerr);
+        return 1;
+    }
+    try {
+        while (pos < args.size()) {
+            const std::string command = args[pos++];
+            bool ok;
+            if (command == "index") ok = commandIndex();
+            else if (command == "add") ok = commandAdd();
+            else if (command == "load") ok = commandLoad();
+            else if (command == "save") ok = commandSave();
+            else if (command == "query-length") ok = commandQueryLength();
+            else if (command == "section") ok = commandSection();
+            else if (command == "find") ok = commandFind();
+            else if (command == "match") ok = commandMatch();
+            else if (command == "range") ok = commandRange();
+            else if (command == "query") ok = commandQuery();
+            else if (command == "top") ok = commandTop();
+            else if (command == "dump") ok = commandDump();
+            else if (command == "follow") ok = commandFollow();
+            else if (command == "refresh") ok = commandRefresh();
+            else if (command == "sleep") ok = commandSleep();
+            else if (command == "stats") ok = commandStats();
+            else if (command == "memory") ok = commandMemory();
+            else if (command == "compact") ok = commandCompact();
+            else {
+                std::cerr << "Error: Unknown command " << command << "\n";
+                out.flush();
+                printUsage(std::cerr);
+                return 1;
+            }
+            if (!ok) {
+                out.flush();
+                return 2;
+            }
+        }
+    } catch (const std::bad_alloc& e) {
+        out.flush();
+        std::cerr << "FATAL ERROR: Memory allocation failed: " << e.what() << std::endl;
+        return 2;
+    } catch (const std::exception& e) {
+        out.flush();
+        std::cerr << "ERROR: An exception occurred: " << e.what() << std::endl;
+        return 2;
+    }
+    return out.flush() ? 0 : 2;
+}
+
+bool IndexerCLI::isCommand(const std::string& word) {
+    return word == "index" || word == "add" || word == "load" || word == "save" ||
+           word == "query-length" || word == "section" || word == "find" || word == "dump" ||
+           word == "match" || word == "range" || word == "query" || word == "top" ||
+           word == "follow" || word == "refresh" || word == "sleep" || word == "stats" ||
+           word == "memory" || word == "compact";
+}
+
+bool IndexerCLI::nextWord(const std::string& command, std::string& word) {
+    if (pos >= args.size()) {
+        std::cerr << "Error: " << command << " needs an argument.\n";
+        return false;
+    }
+    word = args[pos++];
+    return true;
+}
+
+bool IndexerCLI::parseNumber(const std::string& word, size_t& value) {
+    if (word.empty() || word.size() > 18) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < word.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(word[i])))
+            return false;
+        value = value * 10 + static_cast<size_t>(word[i] - '0');
+    }
+    return true;
+}
+
+void IndexerCLI::printUsage(std::ostream& os) const {
+    os << "Usage: test_ui [--threads N] [--dedup] [--fold-case] [--strip-punct] [--no-verify] [--memory-budget MB]\n"
+       << "              COMMAND [ARGS]...\n"
+       << "  --fold-case        Index tokens lowercased (ASCII and Latin-1 letters)\n"
+       << "  --strip-punct      Index tokens without leading/trailing punctuation\n"
+       << "  --memory-budget MB Compact the index while indexing past MB megabytes, warn if still over\n"
+       << "Commands run in order:\n"
+       << "  index FILE...      Index one file, or several files as a corpus\n"
+       << "  add FILE           Add a file to the corpus\n"
+       << "  load INDEX         Load an index written by save\n"
+       << "  save INDEX         Write the index\n"
+       << "  query-length N     Print tokens of length N\n"
+       << "  section X          Print tokens of section X (A-Z or *)\n"
+       << "  find TOKEN         Print one token\n"
+       << "  match PATTERN      Print tokens matching PATTERN (* any run, ? one byte; inter* is a prefix)\n"
+       << "  range FIRST LAST   Print tokens from FIRST to LAST inclusive\n"
+       << "  query EXPR         Print lines matching EXPR, e.g. 'cat AND (dog OR \"big bird\") AND NOT fish'\n"
+       << "  top K [X]          Print the K most frequent tokens as \"count token\" (in section X if given)\n"
+       << "  dump               Print the whole index\n"
+       << "  follow FILE        Index the complete lines of a growing file and follow it\n"
+       << "  refresh            Index lines appended to the followed file since the last refresh\n"
+       << "  sleep SECONDS      Wait, e.g. between refreshes\n"
+       << "  stats              Print performance counters as JSON (build with -DINDEXER_INSTRUMENT)\n"
+       << "  memory             Print the bytes the index holds, per section and kind, as JSON\n"
+       << "  compact            Trim posting lists and indexes to their contents\n"
+       << "Run without arguments for the interactive menu.\n";
+}
+
+bool IndexerCLI::commandIndex() {
+    std::vector<std::string> files;
+    while (pos < args.size() && !isCommand(args[pos])) {
+        files.push_back(args[pos++]);
+    }
+    if (files.empty()) {
+        std::cerr << "Error: index needs at least one file.\n";
+        return false;
+    }
+    if (files.size() == 1) {
+        return index.processTextFile(files[0]);
+    }
+    index.processCorpus(files);
+    return index.documentCount() == files.size();
+}
+
+bool IndexerCLI::commandAdd() {
+    std::string filename;
+    return nextWord("add", filename) && index.addFile(filename) >= 0;
+}
+
+bool IndexerCLI::commandLoad() {
+    std::string filename;
+    return nextWord("load", filename) && index.load(filename, verifyChecksum);
+}
+
+bool IndexerCLI::commandSave() {
+    std::string filename;
+    return nextWord("save", filename) && index.save(filename);
+}
+
+bool IndexerCLI::commandQueryLength() {
+    std::string word;
+    size_t length = 0;
+    if (!nextWord("query-length", word)) {
+        return false;
+    }
+    if (!parseNumber(word, length)) {
+        std::cerr << "Error: Invalid length " << word << "\n";
+        return false;
+    }
+    printTokens(index.tokensByLength(length));
+    return true;
+}
+
+bool IndexerCLI::commandSection() {
+    std::string word;
+    if (!nextWord("section", word)) {
+        return false;
+    }
+    if (word.size() != 1 || !(std::isalpha(static_cast<unsigned char>(word[0])) || word[0] == '*')) {
+        std::cerr << "Error: Invalid section " << word << " (expected A-Z or *)\n";
+        return false;
+    }
+    printTokens(index.tokensInSection(word[0]));
+    return true;
+}
+
+bool IndexerCLI::commandFind() {
+    std::string word;
+    if (!nextWord("find", word)) {
+        return false;
+    }
+    const IndexedToken* token = index.find(word);
+    if (token) {
+        printTokens(std::vector<const IndexedToken*>(1, token));
+    }
+    return true;
+}
+
+bool IndexerCLI::commandMatch() {
+    std::string pattern;
+    if (!nextWord("match", pattern)) {
+        return false;
+    }
+    printTokens(index.tokensMatching(pattern));
+    return true;
+}
+
+bool IndexerCLI::commandRange() {
+    std::string first;
+    std::string last;
+    if (!nextWord("range", first) || !nextWord("range", last)) {
+        return false;
+    }
+    printTokens(index.tokensInRange(first, last));
+    return true;
+}
+
+bool IndexerCLI::commandQuery() {
+    std::string expression;
+    if (!nextWord("query", expression)) {
+        return false;
+    }
+    std::vector<LineHit> hits;
+    try {
+        hits = index.linesMatching(expression);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return false;
+    }
+    for (size_t i = 0; i < hits.size(); ++i) {
+        if (i > 0) {
+            out.append(' ');
+        }
+        if (index.isCorpus()) {
+            out.appendInt(hits[i].docId);
+            out.append(':');
+        }
+        out.appendInt(hits[i].line);
+    }
+    if (!hits.empty()) {
+        out.append('\n');
+    }
+    return true;
+}
+
+bool IndexerCLI::commandTop() {
+    std::string word;
+    size_t count = 0;
+    if (!nextWord("top", word)) {
+        return false;
+    }
+    if (!parseNumber(word, count)) {
+        std::cerr << "Error: Invalid count " << word << "\n";
+        return false;
+    }
+    // An optional section follows; a single letter or * is never a command
+    std::vector<const IndexedToken*> tokens;
+    if (pos < args.size() && args[pos].size() == 1 &&
+        (std::isalpha(static_cast<unsigned char>(args[pos][0])) || args[pos][0] == '*')) {
+        tokens = index.mostFrequent(count, args[pos++][0]);
+    } else {
+        tokens = index.mostFrequent(count);
+    }
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        out.appendInt(static_cast<long long>(tokens[i]->getLineNumbers().getSize()));
+        out.append(' ');
+        out.append(tokens[i]->getToken().c_str(), tokens[i]->getToken().length());
+        out.append('\n');
+    }
+    return true;
+}
+
+bool IndexerCLI::commandDump() {
+    index.print(out);
+    return true;
+}
+
+bool IndexerCLI::commandFollow() {
+    std::string filename;
+    return nextWord("follow", filename) && index.followFile(filename);
+}
+
+bool IndexerCLI::commandRefresh() {
+    if (!index.isFollowing()) {
+        std::cerr << "Error: refresh needs a followed file (use follow FILE).\n";
+        return false;
+    }
+    return index.refresh() >= 0;
+}
+
+bool IndexerCLI::commandSleep() {
+    std::string word;
+    size_t seconds = 0;
+    if (!nextWord("sleep", word)) {
+        return false;
+    }
+    if (!parseNumber(word, seconds)) {
+        std::cerr << "Error: Invalid duration " << word << "\n";
+        return false;
+    }
+    out.flush(); // Show results so far before waiting
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    return true;
+}
+
+bool IndexerCLI::commandStats() {
+    std::ostringstream report;
+    Instrument::printJson(report);
+    const std::string text = report.str();
+    out.append(text.c_str(), text.size());
+    return true;
+}
+
+bool IndexerCLI::commandMemory() {
+    MemoryReport report = index.memoryUsage();
+    out.append("{\n  \"sections\": {");
+    bool first = true;
+    for (int i = 0; i < 27; ++i) {
+        if (report.sections[i].heapBytes() == 0) {
+            continue;
+        }
+        out.append(first ? "\n    \"" : ",\n    \"");
+        out.append(i < 26 ? static_cast<char>('a' + i) : '*');
+        out.append("\": ");
+        appendMemoryUsage(report.sections[i]);
+        first = false;
+    }
+    out.append("\n  },\n  \"shared\": ");
+    appendMemoryUsage(report.shared);
+    out.append(",\n  \"total\": ");
+    appendMemoryUsage(report.total);
+    out.append(",\n  \"budget\": ");
+    const std::string budget = std::to_string(index.getMemoryBudget());
+    out.append(budget.c_str(), budget.size());
+    out.append("\n}\n");
+    return true;
+}
+
+bool IndexerCLI::commandCompact() {
+    index.compact();
+    return true;
+}
+
+void IndexerCLI::appendMemoryUsage(const MemoryUsage& usage) {
+    const char* names[] = { "{\"text\": ", ", \"nodes\": ", ", \"postings\": ", ", \"posting_slack\": ",
+                            ", \"lookup\": ", ", \"allocator_slack\": ", ", \"mapped\": ", ", \"heap\": " };
+    size_t values[] = { usage.tokenText, usage.nodes, usage.postings, usage.postingSlack,
+                        usage.lookup, usage.allocatorSlack, usage.mapped, usage.heapBytes() };
+    for (size_t i = 0; i < 8; ++i) {
+        const std::string value = std::to_string(values[i]);
+        out.append(names[i]);
+        out.append(value.c_str(), value.size());
+    }
+    out.append('}');
+}
+
+void IndexerCLI::printTokens(const std::vector<const IndexedToken*>& tokens) {
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        tokens[i]->print(out);
+        out.append('\n');
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef INDEXERCLI_H
+#define INDEXERCLI_H
+
+#include "Indexer.h"
+#include "OutputBuffer.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Non-interactive front end: runs the commands given on the command line in order.
+//
+//   test_ui [--threads N] [--dedup] [--fold-case] [--strip-punct] [--no-verify] [--memory-budget MB]
+//           COMMAND [ARGS]...
+//
+//   index FILE...      Index one file, or several files as a corpus
+//   add FILE           Add a file to the corpus
+//   load INDEX         Load an index written by save
+//   save INDEX         Write the index
+//   query-length N     Print tokens of length N, one per line
+//   section X          Print tokens of section X (A-Z or *), one per line
+//   find TOKEN         Print one token, or nothing if absent
+//   match PATTERN      Print tokens matching PATTERN (* any run, ? one byte), one per line
+//   range FIRST LAST   Print tokens from FIRST to LAST inclusive, one per line
+//   query EXPR         Print the lines matching a Boolean expression (AND, OR, NOT, "same line")
+//   top K [X]          Print the K most frequent tokens as "count token" (in section X if given)
+//   dump               Print the whole index
+//   follow FILE        Index the complete lines of a growing file and follow it
+//   refresh            Index lines appended to the followed file since the last refresh
+//   sleep SECONDS      Wait, e.g. between refreshes
+//   stats              Print performance counters as JSON (all zero unless built with INDEXER_INSTRUMENT)
+//   memory             Print Indexer::memoryUsage as JSON (sections, shared, total, budget)
+//   compact            Trim posting lists and indexes to their contents
+class IndexerCLI {
+private:
+    Indexer index;              // The index
+    bool verifyChecksum;        // Verify index files on load
+    std::vector<std::string> args;  // Command-line words after the program name
+    size_t pos;                 // Next word to consume
+    OutputBuffer out;           // Command output, written straight to stdout in large blocks
+
+    // Parsing Helpers
+    static bool isCommand(const std::string& word);
+    bool nextWord(const std::string& command, std::string& word); // Argument of command
+    static bool parseNumber(const std::string& word, size_t& value);
+    void printUsage(std::ostream& os) const;
+
+    // Command Helpers (false on failure, after reporting to std::cerr)
+    bool commandIndex();
+    bool commandAdd();
+    bool commandLoad();
+    bool commandSave();
+    bool commandQueryLength();
+    bool commandSection();
+    bool commandFind();
+    bool commandMatch();
+    bool commandRange();
+    bool commandQuery();
+    bool commandTop();
+    bool commandDump();
+    bool commandFollow();
+    bool commandRefresh();
+    bool commandSleep();
+    bool commandStats();
+    bool commandMemory();
+    bool commandCompact();
+    void printTokens(const std::vector<const IndexedToken*>& tokens);
+    void appendMemoryUsage(const MemoryUsage& usage); // One MemoryUsage as a JSON object
+
+public:
+    // Constructor.
+    IndexerCLI();
+
+    // --- Rule of Five ---
+    ~IndexerCLI() = default;
+    IndexerCLI(const IndexerCLI& other) = delete;
+    IndexerCLI& operator=(const IndexerCLI& other) = delete;
+    IndexerCLI(IndexerCLI&& other) noexcept = default;
+    IndexerCLI& operator=(IndexerCLI&& other) noexcept = default;
+    // --- End Rule of Five ---
+
+    // Runs the commands in argv; returns the process exit status
+    // (0 success, 1 usage error, 2 failed command).
+    int run(int argc, char* argv[]);
+};
+
+#endif  // INDEXERCLI_H
@@ -1,4 +1,5 @@
 #include "IndexerUI.h"
+#include "Instrument.h"
 #include <cctype>
 #include <fstream>
 #include <iostream>
@@ -8,6 +9,9 @@
 #include <stdexcept>
 #include <string>
 
+constexpr int IndexerUI::exitChoice;
+constexpr int IndexerUI::lastChoice;
+
 IndexerUI::IndexerUI() : currentFilename("") {}
 
 void IndexerUI::run() {
@@ -21,12 +25,16 @@ void IndexerUI::run() {
                 case 2: processDisplayAll(); break;
                 case 3: processShowByLength(); break;
                 case 4: processViewSection(); break;
-                case 5: std::cout << "\nExiting program. Goodbye!" << std::endl; break;
+                case exitChoice: std::cout << "\nExiting program. Goodbye!" << std::endl; break;
+                case 6: processSearch(); break;
+                case 7: processLineQuery(); break;
+                case 8: processMostFrequent(); break;
+                case 9: processStatistics(); break;
             }
         } catch (const std::bad_alloc& e) {
             std::cerr << "\n********\nFATAL ERROR: Memory allocation failed: "
                       << e.what() << "\n********" << std::endl;
-            choice = 5;
+            choice = exitChoice;
         } catch (const std::exception& e) {
             std::cerr << "\n********\nERROR: An exception occurred: " << e.what()
                       << "\n********" << std::endl;
@@ -34,7 +42,7 @@ void IndexerUI::run() {
             std::cerr << "\n********\nERROR: An unknown exception occurred.\n********"
                       << std::endl;
         }
-    } while (choice != 5);
+    } while (choice != exitChoice);
 }
 
 void IndexerUI::displayMenu() const {
@@ -43,15 +51,22 @@ void IndexerUI::displayMenu() const {
               << "2. Show tokens in all sections\n"
               << "3. Find tokens by length\n"
               << "4. View tokens by section\n"
-              << "5. Exit\n"
+              << "6. Search tokens (pattern or range)\n"
+              << "7. Find lines (AND, OR, NOT)\n"
+              << "8. Show most frequent tokens\n"
+              << "9. Show memory usage and performance counters\n"
+              << exitChoice << ". Exit\n"
               << "==================================\n";
 }
 
 int IndexerUI::getUserChoice() const {
     int choice = 0;
-    std::cout << "Enter your choice (1-5): ";
-    while (!(std::cin >> choice) || choice < 1 || choice > 5) {
-        std::cerr << "Invalid input. Please enter a number between 1 and 5: ";
+    std::cout << "Enter your choice (1-" << lastChoice << "): ";
+    while (!(std::cin >> choice) || choice < 1 || choice > lastChoice) {
+        if (std::cin.fail() && std::cin.eof()) {
+            return exitChoice;      // End of input: leave instead of re-prompting forever
+        }
+        std::cerr << "Invalid input. Please enter a number between 1 and " << lastChoice << ": ";
         std::cin.clear();
         std::cin.ignore(max_stream_size, '\n');
     }
@@ -63,7 +78,8 @@ char IndexerUI::getConfirmation() const {
     char confirm = ' ';
     std::cout << " (y/n): ";
     while (true) {
-        std::cin >> confirm;
+        if (!(std::cin >> confirm))
+            return 'n';             // End of input declines
         std::cin.ignore(max_stream_size, '\n');
         confirm = std::tolower(static_cast<unsigned char>(confirm));
         if (confirm == 'y' || confirm == 'n')
@@ -86,6 +102,8 @@ size_t IndexerUI::getSearchLength() const {
                 return static_cast<size_t>(inputLength);
             }
         } else {
+            if (std::cin.fail() && std::cin.eof())
+                throw std::runtime_error("Unexpected end of input");
             std::cerr << "Invalid input. Please enter a non-negative integer: ";
             std::cin.clear();
             std::cin.ignore(max_stream_size, '\n');
@@ -94,11 +112,29 @@ size_t IndexerUI::getSearchLength() const {
     }
 }
 
+size_t IndexerUI::getTopCount() const {
+    long long count = 0;
+    std::cout << "Enter how many tokens to show (1 or more): ";
+    while (true) {
+        std::cin >> count;
+        if (std::cin.good() && count > 0) {
+            std::cin.ignore(max_stream_size, '\n');
+            return static_cast<size_t>(count);
+        }
+        if (std::cin.fail() && std::cin.eof())
+            throw std::runtime_error("Unexpected end of input");
+        std::cerr << "Invalid input. Please enter a positive integer: ";
+        std::cin.clear();
+        std::cin.ignore(max_stream_size, '\n');
+    }
+}
+
 char IndexerUI::getSectionChar() const {
     char sectionChar = ' ';
     std::cout << "Enter section character (A-Z or *): ";
     while (true) {
-        std::cin >> sectionChar;
+        if (!(std::cin >> sectionChar))
+            throw std::runtime_error("Unexpected end of input");
         std::cin.ignore(max_stream_size, '\n');
         if (std::isalpha(static_cast<unsigned char>(sectionChar)) || sectionChar == '*')
             return sectionChar;
@@ -106,6 +142,19 @@ char IndexerUI::getSectionChar() const {
     }
 }
 
+std::string IndexerUI::getSearchQuery(const char* prompt) const {
+    std::string query;
+    std::cout << prompt;
+    while (true) {
+        if (!std::getline(std::cin, query)) {
+            return query;
+        }
+        if (!query.empty())
+            return query;
+        std::cerr << "Invalid input. Please enter a query: ";
+    }
+}
+
 std::string IndexerUI::getFileName() const {
     std::string filename;
     std::cout << "Enter the filename to index: ";
@@ -158,6 +207,57 @@ void IndexerUI::processViewSection() {
     index.ViewBySection(sectionChar);
 }
 
+void IndexerUI::processSearch() {
+    if (index.isEmpty()) {
+        std::cout << "\nIndex is empty.\n";
+        return;
+    }
+    std::string query = getSearchQuery("Enter a pattern (inter*, ?at, *ing) or a range (from..to): ");
+    size_t dots = query.find("..");
+    if (dots != std::string::npos) {
+        index.listRange(query.substr(0, dots), query.substr(dots + 2));
+    } else {
+        index.listMatching(query);
+    }
+}
+
+void IndexerUI::processLineQuery() {
+    if (index.isEmpty()) {
+        std::cout << "\nIndex is empty.\n";
+        return;
+    }
+    std::string query = getSearchQuery("Enter a query (cat AND dog, cat OR dog, cat AND NOT dog, \"cat dog\"): ");
+    index.listQuery(query);
+}
+
+void IndexerUI::processMostFrequent() {
+    if (index.isEmpty()) {
+        std::cout << "\nIndex is empty.\n";
+        return;
+    }
+    size_t count = getTopCount();
+    std::cout << "Limit to one section?";
+    if (getConfirmation() == 'y') {
+        char sectionChar = getSectionChar();
+        index.listMostFrequent(count, sectionChar);
+    } else {
+        index.listMostFrequent(count);
+    }
+}
+
+void IndexerUI::processStatistics() {
+    index.listMemoryUsage();
+    std::cout << "\n";
+    Instrument::print(std::cout);
+    if (!Instrument::isEnabled()) {
+        return;
+    }
+    std::cout << "Reset counters?";
+    if (getConfirmation() == 'y') {
+        Instrument::reset();
+    }
+}
+
 int IndexerUI::getSectionIndexFromChar(char firstChar) const {
     if (std::isalpha(static_cast<unsigned char>(firstChar)))
         return std::tolower(static_cast<unsigned char>(firstChar)) - 'a';
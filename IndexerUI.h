@@ -11,20 +11,29 @@ private:
     Indexer index;          // The index 
     std::string currentFilename;  // Name of the currently indexed file.
     static constexpr auto max_stream_size = std::numeric_limits<std::streamsize>::max();
+    // Exit keeps its original number so scripted sessions still end; new options go after it.
+    static constexpr int exitChoice = 5;
+    static constexpr int lastChoice = 9;
 
     // UI Helpers
     void displayMenu() const;
     int getUserChoice() const;      // Robust menu choice input.
     char getConfirmation() const;   // Robust y/n input.
     size_t getSearchLength() const; // Robust length input.
+    size_t getTopCount() const;     // Robust positive count input.
     char getSectionChar() const;    // Robust section character input.
     std::string getFileName() const;    // Robust file name query.
+    std::string getSearchQuery(const char* prompt) const; // Non-empty query input.
 
     // Processing Helpers
     void processIndexFile();
     void processDisplayAll();
     void processShowByLength();
     void processViewSection();
+    void processSearch();           // Wildcard pattern or from..to range.
+    void processLineQuery();        // Boolean query over lines.
+    void processMostFrequent();     // Top tokens by count, overall or per section.
+    void processStatistics();       // Memory usage, then the instrumentation report.
 
     // Utility Helper
     int getSectionIndexFromChar(char firstChar) const; // Maps char to section.
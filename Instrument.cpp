@@ -0,0 +1,226 @@
+// Instrument.cpp
+// Purpose: Implement Instrument. Every thread that reports gets a block of counters from a
+// registry; blocks are never freed, and a block released by an exiting thread is handed to
+// the next new thread, so totals survive the short-lived workers of parallel ingest. Values
+// are relaxed atomics written only by their owning thread: an update is a plain load and
+// store, and a report running on another thread reads consistent (if slightly stale) values.
+
+#include "Instrument.h"
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+
+namespace {
+
+// Slots of a block: counters, then phase calls, then phase nanoseconds
+const int callsSlot = Instrument::counterCount;
+const int nanosSlot = callsSlot + Instrument::phaseCount;
+const int slotCount = nanosSlot + Instrument::phaseCount;
+
+// Counters of one thread
+struct Block {
+    std::atomic<uint64_t> values[slotCount];
+    Block* next;                // Next block in the registry
+    bool inUse;                 // Owned by a live thread
+};
+
+std::mutex registryMutex;
+Block* registry = nullptr;      // Every block ever created (guarded by registryMutex)
+
+// Zero all values of a block
+void zero(Block& block) {
+    for (int i = 0; i < slotCount; ++i) {
+        block.values[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+// Reuse a released block, else register a new one
+Block* acquireBlock() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (Block* block = registry; block; block = block->next) {
+        if (!block->inUse) {
+            block->inUse = true;
+            return block;
+        }
+    }
+    Block* block = new Block;
+    zero(*block);
+    block->inUse = true;
+    block->next = registry;
+    registry = block;
+    return block;
+}
+
+// Return a block (its counts stay in the totals)
+void releaseBlock(Block* block) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    block->inUse = false;
+}
+
+// Holds the calling thread's block for the thread's lifetime
+struct ThreadBlock {
+    Block* block;
+    ThreadBlock() : block(acquireBlock()) {}
+    ~ThreadBlock() { releaseBlock(block); }
+};
+
+Block& localBlock() {
+    thread_local ThreadBlock slot;
+    return *slot.block;
+}
+
+// Add n to a value owned by this thread
+inline void bump(std::atomic<uint64_t>& value, uint64_t n) {
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// Sum one slot over every block
+uint64_t total(int slot) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    uint64_t sum = 0;
+    for (Block* block = registry; block; block = block->next) {
+        sum += block->values[slot].load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+const char* const counterNames[Instrument::counterCount] = {
+    "files_opened", "bytes_read", "tokens_processed", "tokens_found", "tokens_inserted",
+    "postings_appended", "list_inserts", "list_index_shifts", "list_node_hops",
+    "list_index_rebuilds", "list_sorts", "intlist_growths", "intlist_bytes_copied",
+    "token_allocations", "token_bytes_allocated", "arena_blocks"
+};
+
+const char* const phaseNames[Instrument::phaseCount] = {
+    "index_file", "read_file", "tokenize", "process_tokens", "sort_section", "merge_sections",
+    "save_index", "load_index"
+};
+
+} // namespace
+
+// Implements: explicit ScopedTimer(Phase phase);
+// ScopedTimer: Start timing phase
+Instrument::ScopedTimer::ScopedTimer(Phase phase) : phase(phase), start(std::chrono::steady_clock::now()) {}
+
+// Implements: ~ScopedTimer();
+// ~ScopedTimer: Charge the elapsed time to the phase
+Instrument::ScopedTimer::~ScopedTimer() {
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+    addTime(phase, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+}
+
+// Implements: Stopwatch();
+// Stopwatch: Start the first lap
+Instrument::Stopwatch::Stopwatch() : last(std::chrono::steady_clock::now()) {}
+
+// Implements: void lap(Phase phase);
+// lap: Charge the time since the previous lap to phase
+void Instrument::Stopwatch::lap(Phase phase) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    addTime(phase, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count()));
+    last = now;
+}
+
+// Implements: static bool isEnabled();
+// isEnabled: True if the macros were compiled in
+bool Instrument::isEnabled() {
+#ifdef INDEXER_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Implements: static void add(Counter counter, uint64_t n);
+// add: Count n events in this thread's block
+void Instrument::add(Counter counter, uint64_t n) {
+    bump(localBlock().values[counter], n);
+}
+
+// Implements: static void addTime(Phase phase, uint64_t nanoseconds);
+// addTime: Record one call of phase in this thread's block
+void Instrument::addTime(Phase phase, uint64_t nanoseconds) {
+    Block& block = localBlock();
+    bump(block.values[callsSlot + phase], 1);
+    bump(block.values[nanosSlot + phase], nanoseconds);
+}
+
+// Implements: static uint64_t count(Counter counter);
+// count: Events counted by all threads
+uint64_t Instrument::count(Counter counter) {
+    return total(counter);
+}
+
+// Implements: static uint64_t calls(Phase phase);
+// calls: Calls of phase on all threads
+uint64_t Instrument::calls(Phase phase) {
+    return total(callsSlot + phase);
+}
+
+// Implements: static uint64_t nanoseconds(Phase phase);
+// nanoseconds: Time spent in phase on all threads (parallel phases add up)
+uint64_t Instrument::nanoseconds(Phase phase) {
+    return total(nanosSlot + phase);
+}
+
+// Implements: static void reset();
+// reset: Zero every block
+void Instrument::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (Block* block = registry; block; block = block->next) {
+        zero(*block);
+    }
+}
+
+// Implements: static const char* name(Counter counter);
+// name: Report name of a counter
+const char* Instrument::name(Counter counter) {
+    return counterNames[counter];
+}
+
+// Implements: static const char* name(Phase phase);
+// name: Report name of a phase
+const char* Instrument::name(Phase phase) {
+    return phaseNames[phase];
+}
+
+// Implements: static void print(std::ostream& os);
+// print: Phases (calls, milliseconds) then counters, one per line
+void Instrument::print(std::ostream& os) {
+    if (!isEnabled()) {
+        os << "Instrumentation is compiled out (rebuild with -DINDEXER_INSTRUMENT).\n";
+        return;
+    }
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::left << std::setw(20) << "Phase" << std::right << std::setw(11) << "calls" << std::setw(11) << "ms" << "\n";
+    for (int i = 0; i < phaseCount; ++i) {
+        Phase phase = static_cast<Phase>(i);
+        os << std::left << std::setw(20) << name(phase) << std::right << std::setw(11) << calls(phase)
+           << std::setw(11) << std::fixed << std::setprecision(3) << nanoseconds(phase) / 1e6 << "\n";
+    }
+    os << std::left << std::setw(24) << "Counter" << std::right << std::setw(15) << "total" << "\n";
+    for (int i = 0; i < counterCount; ++i) {
+        Counter counter = static_cast<Counter>(i);
+        os << std::left << std::setw(24) << name(counter) << std::right << std::setw(15) << count(counter) << "\n";
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+// Implements: static void printJson(std::ostream& os);
+// printJson: {"enabled", "phases": {name: {"calls", "ns"}}, "counters": {name: total}}
+void Instrument::printJson(std::ostream& os) {
+    os << "{\n  \"enabled\": " << (isEnabled() ? "true" : "false") << ",\n  \"phases\": {";
+    for (int i = 0; i < phaseCount; ++i) {
+        Phase phase = static_cast<Phase>(i);
+        os << (i > 0 ? "," : "") << "\n    \"" << name(phase) << "\": {\"calls\": " << calls(phase)
+           << ", \"ns\": " << nanoseconds(phase) << "}";
+    }
+    os << "\n  },\n  \"counters\": {";
+    for (int i = 0; i < counterCount; ++i) {
+        Counter counter = static_cast<Counter>(i);
+        os << (i > 0 ? "," : "") << "\n    \"" << name(counter) << "\": " << count(counter);
+    }
+    os << "\n  }\n}\n";
+}
@@ -0,0 +1,105 @@
+// Instrument.h
+// Purpose: Declare Instrument, optional counters and phase timers for the indexing hot paths
+// (file reads, tokenizing, token lookup and insertion, DLList node hops, IntList growth,
+// Token and Arena allocations). Code reports through the INDEXER_COUNT / INDEXER_TIMED /
+// INDEXER_LAP macros, which compile to nothing unless INDEXER_INSTRUMENT is defined, so a
+// normal build carries no cost. Each thread counts into its own block (no shared cache lines
+// or locks on the hot path); the reports sum the blocks, so they should run between operations.
+//
+//   g++ -std=c++11 -O2 -pthread -DINDEXER_INSTRUMENT -c *.cpp ...
+
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+class Instrument {
+public:
+    // Event counters
+    enum Counter {
+        filesOpened,            // FileReader::open calls that succeeded
+        bytesRead,              // Bytes handed out by FileReader chunks
+        tokensProcessed,        // processToken calls
+        tokensFound,            // ... whose token already existed
+        tokensInserted,         // ... that created a token
+        postingsAppended,       // Line numbers appended (after dedup)
+        listInserts,            // DLList nodes inserted
+        listIndexShifts,        // nodeIndex entries moved by positional inserts and removes
+        listNodeHops,           // Links walked by positional access while nodeIndex was stale
+        listIndexRebuilds,      // Full nodeIndex rebuilds
+        listSorts,              // DLList::sort calls on lists of 2 or more
+        intListGrowths,         // IntList reallocations (resize, unborrow)
+        intListBytesCopied,     // Encoded bytes copied by those reallocations
+        tokenAllocations,       // Token::allocateText calls (heap-owned token text)
+        tokenBytesAllocated,    // Bytes allocated by those calls
+        arenaBlocks,            // Arena blocks allocated (not reused)
+        counterCount
+    };
+
+    // Timed phases (calls and total time)
+    enum Phase {
+        indexFile,              // processTextFile / followFile: open to last token
+        readFile,               // FileReader::open and nextChunk (a mapped file is paged in later)
+        tokenize,               // Tokenizer batches
+        processTokens,          // processToken over each batch (lookup, insert, posting append)
+        sortSection,            // Deferred section sorts
+        mergeSections,          // Folding partial indexes in (parallel and corpus ingest)
+        saveIndex,              // save
+        loadIndex,              // load
+        phaseCount
+    };
+
+    // Times the enclosing scope into a phase
+    class ScopedTimer {
+    private:
+        Phase phase;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        explicit ScopedTimer(Phase phase);
+        ScopedTimer(const ScopedTimer& other) = delete;
+        ScopedTimer& operator=(const ScopedTimer& other) = delete;
+        ~ScopedTimer();
+    };
+
+    // Charges the time since the previous lap (or construction) to a phase; for loops that
+    // alternate between phases
+    class Stopwatch {
+    private:
+        std::chrono::steady_clock::time_point last;
+
+    public:
+        Stopwatch();
+        void lap(Phase phase);
+    };
+
+    static bool isEnabled();                        // Built with INDEXER_INSTRUMENT
+    static void add(Counter counter, uint64_t n);   // Count n events on this thread
+    static void addTime(Phase phase, uint64_t nanoseconds); // One call of phase on this thread
+    static uint64_t count(Counter counter);         // Total over all threads
+    static uint64_t calls(Phase phase);             // Total over all threads
+    static uint64_t nanoseconds(Phase phase);       // Total over all threads
+    static void reset();                            // Zero every counter and phase
+    static void print(std::ostream& os);            // Human-readable report
+    static void printJson(std::ostream& os);        // Report as one JSON object
+    static const char* name(Counter counter);       // snake_case name used in reports
+    static const char* name(Phase phase);
+};
+
+#ifdef INDEXER_INSTRUMENT
+#define INDEXER_CONCAT_(a, b) a##b
+#define INDEXER_CONCAT(a, b) INDEXER_CONCAT_(a, b)
+#define INDEXER_COUNT(counter, n) Instrument::add(Instrument::counter, (n))
+#define INDEXER_TIMED(phase) Instrument::ScopedTimer INDEXER_CONCAT(indexerTimer, __LINE__)(Instrument::phase)
+#define INDEXER_STOPWATCH(watch) Instrument::Stopwatch watch
+#define INDEXER_LAP(watch, phase) watch.lap(Instrument::phase)
+#else
+#define INDEXER_COUNT(counter, n) ((void)0)
+#define INDEXER_TIMED(phase) ((void)0)
+#define INDEXER_STOPWATCH(watch) ((void)0)
+#define INDEXER_LAP(watch, phase) ((void)0)
+#endif
+
+#endif // INSTRUMENT_H
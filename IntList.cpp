@@ -1,37 +1,41 @@
 // TO-DO for IntList.cpp
-// Purpose: Implement IntList class member functions to manage a dynamic sequence of integers.
+// Purpose: Implement IntList class member functions to manage a compressed sequence of integers
+// (zigzag delta + varint, with a decode checkpoint every 64 values).
 
 // 1. Include header file
 //    - Include IntList.h to access the class declaration.
 
-// 2. Implement private helper function
-//    - resize: Doubles capacity (starts at 2), reallocates array, copies elements.
+// 2. Implement private helper functions
+//    - resize: Doubles byte capacity (starts inline), moves bytes to the heap, copies them.
+//    - data: Return inline, heap or borrowed bytes.
+//    - unborrow: Copy borrowed bytes and checkpoints to the heap before the first change.
 
 // 3. Implement default constructor
-//    - Initialize empty state: pData = nullptr, size = 0, capacity = 0.
+//    - Initialize empty inline state: size = 0, used = 0, capacity = inlineBytes.
 
 // 4. Implement copy constructor
-//    - Deep copy other’s array, set size and capacity.
+//    - Deep copy other’s bytes and checkpoints; a borrowed list is copied into owned storage of its
+//      exact size, so the copy outlives the mapped file it came from.
 
 // 5. Implement move constructor
-//    - Transfer pData, size, capacity; set other to empty (pData = nullptr, size = 0, capacity = 0).
+//    - Transfer bytes and checkpoints; set other to empty inline state.
 //    - Mark as noexcept.
 
 // 6. Implement destructor
-//    - Deallocate pData using delete[].
+//    - Deallocate heap bytes and checkpoints using delete[].
 
 // 7. Implement copy assignment operator
-//    - Check self-assignment, deallocate pData, deep copy other’s array, update size and capacity.
+//    - Check self-assignment, deallocate, deep copy other’s bytes and checkpoints.
 
 // 8. Implement move assignment operator
-//    - Check self-assignment, deallocate pData, transfer other’s pData, size, and capacity; set other to empty.
+//    - Check self-assignment, deallocate, transfer other’s bytes and checkpoints; set other to empty.
 //    - Mark as noexcept.
 
 // 9. Implement append
-//    - Add lineNumber to end, resize if size == capacity, increment size.
+//    - Record a checkpoint every 64 values, encode the delta, resize if the bytes may not fit.
 
 // 10. Implement clear
-//     - Deallocate pData, set pData = nullptr, size = 0, capacity = 0.
+//     - Deallocate, reset to empty inline state.
 
 // 11. Implement getSize
 //     - Return size.
@@ -42,78 +46,185 @@
 //     - Mark as const.
 
 // 13. Implement isFull
-//     - Return true if size == capacity.
+//     - Return true if a maximum-length varint would not fit.
 //     - Mark as const.
 
 // 14. Implement print
-//     - Write elements to ostream, separated by spaces.
+//     - Write elements to ostream (or OutputBuffer), separated by spaces.
 //     - Mark as const.
 
 // 15. Implement getElementAt
-//     - Return element at index, throw std::out_of_range if index >= size.
+//     - Decode from the nearest checkpoint, throw std::out_of_range if index >= size.
 //     - Mark as const.
 
+// 16. Implement back, begin, end, bytesUsed, bytesReserved
+//     - Mark as const.
+//     - Borrowed bytes are not counted as reserved.
+
+// 17. Implement encoded, borrow, checkpointCount, checkpointBytes
+//     - borrow: Wrap external bytes with capacity = 0; they must outlive the list.
+
+// 18. Implement const_iterator
+//     - Decode the next varint on each increment.
+
+// 19. Implement iteratorAt and advanceTo
+//     - iteratorAt: Start decoding at the checkpoint before index, as getElementAt does.
+//     - advanceTo: Checkpoint k records the value just before index k * 64, so the checkpoints are
+//       a sorted sample of the list. Gallop over them (1, 2, 4, ... checkpoints ahead), binary
+//       search the last step, then decode at most 64 values. A skip of d values costs
+//       O(log(d / 64) + 64) instead of O(d).
+
+// 20. Implement shrinkToFit
+//     - Reallocate heap bytes to used (inline if they fit); a later append doubles from there.
+
 #include "IntList.h"
+#include "Instrument.h"
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// Longest varint for a zigzag-encoded 33-bit delta
+const unsigned int maxVarintBytes = 5;
+
+// Write v as a little-endian base-128 varint, return bytes written
+inline unsigned int encodeVarint(unsigned long long v, unsigned char* out) {
+    unsigned int n = 0;
+    while (v >= 0x80) {
+        out[n++] = static_cast<unsigned char>(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = static_cast<unsigned char>(v);
+    return n;
+}
+
+// Read one varint-encoded zigzag delta and apply it to prev
+inline int decodeNext(const unsigned char*& p, int prev) {
+    unsigned long long v = 0;
+    unsigned int shift = 0;
+    unsigned char byte;
+    do {
+        byte = *p++;
+        v |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    long long delta = static_cast<long long>(v >> 1) ^ -static_cast<long long>(v & 1);
+    return static_cast<int>(prev + delta);
+}
+
+// Checkpoint array capacity for a given entry count (4, then powers of two)
+inline size_t skipCapacity(size_t count) {
+    size_t cap = 4;
+    while (cap < count) {
+        cap *= 2;
+    }
+    return cap;
+}
+
+} // namespace
 
 // Implements: void resize();
-// Private helper: Doubles capacity (starts at 2), reallocates array
+// Private helper: Doubles byte capacity, moving inline bytes to the heap
 void IntList::resize() {
-    size_t newCapacity = (capacity == 0) ? 2 : capacity * 2;
-    int* newData = new int[newCapacity];
-    for (size_t i = 0; i < size; ++i) {
-        newData[i] = pData[i];
+    unsigned int newCapacity = capacity * 2;
+    unsigned char* newData = new unsigned char[newCapacity];
+    std::memcpy(newData, data(), used);
+    INDEXER_COUNT(intListGrowths, 1);
+    INDEXER_COUNT(intListBytesCopied, used);
+    if (capacity > inlineBytes) {
+        delete[] pData;
+    }
+    pData = newData;
+    capacity = newCapacity;
+}
+
+// Implements: void unborrow();
+// Private helper: Copy borrowed bytes and checkpoints into owned storage
+void IntList::unborrow() {
+    unsigned int newCapacity = inlineBytes * 2;
+    while (newCapacity < used + maxVarintBytes) {
+        newCapacity *= 2;
+    }
+    unsigned char* newData = new unsigned char[newCapacity];
+    std::memcpy(newData, pData, used);
+    INDEXER_COUNT(intListGrowths, 1);
+    INDEXER_COUNT(intListBytesCopied, used);
+    SkipEntry* newSkips = nullptr;
+    if (pSkips) {
+        size_t count = (size - 1) / skipInterval;
+        newSkips = new SkipEntry[skipCapacity(count)];
+        std::memcpy(newSkips, pSkips, count * sizeof(SkipEntry));
     }
-    delete[] pData;
     pData = newData;
+    pSkips = newSkips;
     capacity = newCapacity;
 }
 
+// Implements: unsigned char* data();
+// Private helper: Return inline, heap or borrowed bytes
+unsigned char* IntList::data() {
+    return (capacity != inlineBytes) ? pData : inlineData;
+}
+
+// Implements: const unsigned char* data() const;
+// Private helper: Return inline, heap or borrowed bytes
+const unsigned char* IntList::data() const {
+    return (capacity != inlineBytes) ? pData : inlineData;
+}
+
 // Implements: IntList();
-// Default constructor: Empty state
-IntList::IntList() : pData(nullptr), size(0), capacity(0) {}
+// Default constructor: Empty inline state
+IntList::IntList() : pData(nullptr), pSkips(nullptr), size(0), used(0), capacity(inlineBytes), last(0) {}
 
 // Implements: IntList(const IntList& other);
 // Copy constructor: Deep copy
-IntList::IntList(const IntList& other) : size(other.size), capacity(other.capacity) {
-    if (other.pData) {
-        pData = new int[capacity];
-        for (size_t i = 0; i < size; ++i) {
-            pData[i] = other.pData[i];
-        }
-    } else {
-        pData = nullptr;
+IntList::IntList(const IntList& other)
+    : pData(nullptr), pSkips(nullptr), size(other.size), used(other.used),
+      capacity(other.capacity), last(other.last) {
+    if (capacity == 0) {
+        capacity = (used <= inlineBytes) ? inlineBytes : used;
+    }
+    if (capacity > inlineBytes) {
+        pData = new unsigned char[capacity];
+    }
+    std::memcpy(data(), other.data(), used);
+    if (other.pSkips) {
+        size_t count = (size - 1) / skipInterval;
+        pSkips = new SkipEntry[skipCapacity(count)];
+        std::memcpy(pSkips, other.pSkips, count * sizeof(SkipEntry));
     }
 }
 
 // Implements: IntList(IntList&& other) noexcept;
 // Move constructor: Transfer ownership, leave other empty
-IntList::IntList(IntList&& other) noexcept : pData(other.pData), size(other.size), capacity(other.capacity) {
+IntList::IntList(IntList&& other) noexcept
+    : pData(other.pData), pSkips(other.pSkips), size(other.size), used(other.used),
+      capacity(other.capacity), last(other.last) {
     other.pData = nullptr;
+    other.pSkips = nullptr;
     other.size = 0;
-    other.capacity = 0;
+    other.used = 0;
+    other.capacity = inlineBytes;
+    other.last = 0;
 }
 
 // Implements: ~IntList();
-// Destructor: Deallocate pData
+// Destructor: Deallocate heap bytes and checkpoints
 IntList::~IntList() {
-    delete[] pData;
+    if (capacity > inlineBytes) {
+        delete[] pData;
+    }
+    if (capacity != 0) {
+        delete[] pSkips;
+    }
 }
 
 // Implements: IntList& operator=(const IntList& other);
 // Copy assignment operator: Deep copy, handle self-assignment
 IntList& IntList::operator=(const IntList& other) {
     if (this != &other) {
-        delete[] pData;
-        size = other.size;
-        capacity = other.capacity;
-        if (other.pData) {
-            pData = new int[capacity];
-            for (size_t i = 0; i < size; ++i) {
-                pData[i] = other.pData[i];
-            }
-        } else {
-            pData = nullptr;
-        }
+        IntList copy(other);
+        *this = std::move(copy);
     }
     return *this;
 }
@@ -122,34 +233,73 @@ IntList& IntList::operator=(const IntList& other) {
 // Move assignment operator: Transfer ownership, handle self-assignment
 IntList& IntList::operator=(IntList&& other) noexcept {
     if (this != &other) {
-        delete[] pData;
+        if (capacity > inlineBytes) {
+            delete[] pData;
+        }
+        if (capacity != 0) {
+            delete[] pSkips;
+        }
         pData = other.pData;
+        pSkips = other.pSkips;
         size = other.size;
+        used = other.used;
         capacity = other.capacity;
+        last = other.last;
         other.pData = nullptr;
+        other.pSkips = nullptr;
         other.size = 0;
-        other.capacity = 0;
+        other.used = 0;
+        other.capacity = inlineBytes;
+        other.last = 0;
     }
     return *this;
 }
 
 // Implements: void append(int lineNumber);
-// Append: Add lineNumber to end, resize if needed
+// Append: Checkpoint every 64 values, then encode delta from last value
 void IntList::append(int lineNumber) {
-    if (size == capacity) {
+    if (capacity == 0) {
+        unborrow();
+    }
+    if (size > 0 && size % skipInterval == 0) {
+        size_t count = size / skipInterval - 1;   // Checkpoints already stored
+        if (count == 0 || (count >= 4 && skipCapacity(count) == count)) {
+            SkipEntry* newSkips = new SkipEntry[skipCapacity(count + 1)];
+            if (count > 0) {
+                std::memcpy(newSkips, pSkips, count * sizeof(SkipEntry));
+            }
+            delete[] pSkips;
+            pSkips = newSkips;
+        }
+        pSkips[count].offset = used;
+        pSkips[count].prev = last;
+    }
+    if (capacity - used < maxVarintBytes) {
         resize();
     }
-    pData[size] = lineNumber;
+    long long delta = static_cast<long long>(lineNumber) - last;
+    unsigned long long zigzag = (static_cast<unsigned long long>(delta) << 1) ^
+                                static_cast<unsigned long long>(delta >> 63);
+    used += encodeVarint(zigzag, data() + used);
+    last = lineNumber;
     ++size;
 }
 
 // Implements: void clear();
-// Clear: Deallocate pData, reset to empty state
+// Clear: Deallocate, reset to empty inline state
 void IntList::clear() {
-    delete[] pData;
+    if (capacity > inlineBytes) {
+        delete[] pData;
+    }
+    if (capacity != 0) {
+        delete[] pSkips;
+    }
     pData = nullptr;
+    pSkips = nullptr;
     size = 0;
-    capacity = 0;
+    used = 0;
+    capacity = inlineBytes;
+    last = 0;
 }
 
 // Implements: size_t getSize() const;
@@ -165,27 +315,250 @@ bool IntList::isEmpty() const {
 }
 
 // Implements: bool isFull() const;
-// isFull: Check if size equals capacity
+// isFull: Check if a maximum-length varint would not fit
 bool IntList::isFull() const {
-    return size == capacity;
+    return capacity == 0 || capacity - used < maxVarintBytes;
 }
 
 // Implements: void print(std::ostream& os) const;
 // print: Write elements to stream
 void IntList::print(std::ostream& os) const {
-    for (size_t i = 0; i < size; ++i) {
-        os << pData[i];
-        if (i < size - 1) {
+    bool first = true;
+    for (const_iterator it = begin(); it != end(); ++it) {
+        if (!first) {
             os << " ";
         }
+        os << *it;
+        first = false;
+    }
+}
+
+// Implements: void print(OutputBuffer& out) const;
+// print: Append elements to output buffer
+void IntList::print(OutputBuffer& out) const {
+    for (const_iterator it = begin(); it != end(); ++it) {
+        if (it.index > 0) {
+            out.append(' ');
+        }
+        out.appendInt(*it);
     }
 }
 
 // Implements: int getElementAt(size_t index) const;
-// getElementAt: Return element at index, throw if invalid
+// getElementAt: Decode from nearest checkpoint, throw if invalid
 int IntList::getElementAt(size_t index) const {
     if (index >= size) {
         throw std::out_of_range("Index out of range");
     }
-    return pData[index];
-}
\ No newline at end of file
+    size_t checkpoint = index / skipInterval;
+    const unsigned char* p = data();
+    int value = 0;
+    if (checkpoint > 0) {
+        p += pSkips[checkpoint - 1].offset;
+        value = pSkips[checkpoint - 1].prev;
+    }
+    for (size_t i = checkpoint * skipInterval; i <= index; ++i) {
+        value = decodeNext(p, value);
+    }
+    return value;
+}
+
+// Implements: int back() const;
+// back: Return last element, throw if empty
+int IntList::back() const {
+    if (size == 0) {
+        throw std::out_of_range("Index out of range");
+    }
+    return last;
+}
+
+// Implements: const_iterator iteratorAt(size_t index) const;
+// iteratorAt: Iterator at index, decoded from the nearest checkpoint
+IntList::const_iterator IntList::iteratorAt(size_t index) const {
+    if (index >= size) {
+        return end();
+    }
+    size_t checkpoint = index / skipInterval;
+    const_iterator it = (checkpoint > 0)
+        ? const_iterator(data() + pSkips[checkpoint - 1].offset, checkpoint * skipInterval,
+                         pSkips[checkpoint - 1].prev, size)
+        : begin();
+    while (it.index < index) {
+        ++it;
+    }
+    return it;
+}
+
+// Implements: const_iterator advanceTo(const_iterator from, size_t limit, int target) const;
+// advanceTo: First position in [from, limit) whose value is >= target, or limit if none
+IntList::const_iterator IntList::advanceTo(const_iterator from, size_t limit, int target) const {
+    if (limit > size) {
+        limit = size;
+    }
+    if (from.index >= limit || from.value >= target) {
+        return from;
+    }
+    // Usable checkpoints start a value inside (from, limit)
+    size_t lastUsable = checkpointCount(size);
+    if (lastUsable > (limit - 1) / skipInterval) {
+        lastUsable = (limit - 1) / skipInterval;
+    }
+    size_t before = 0;                          // Last checkpoint known to precede target (0: none)
+    size_t probe = from.index / skipInterval + 1; // First checkpoint after from
+    size_t step = 1;
+    while (probe <= lastUsable && pSkips[probe - 1].prev < target) {
+        before = probe;
+        probe += step;
+        step *= 2;
+    }
+    if (before > 0) {
+        size_t after = (probe <= lastUsable) ? probe : lastUsable + 1;
+        while (before + 1 < after) {
+            size_t mid = before + (after - before) / 2;
+            if (pSkips[mid - 1].prev < target) {
+                before = mid;
+            } else {
+                after = mid;
+            }
+        }
+        from = const_iterator(data() + pSkips[before - 1].offset, before * skipInterval,
+                              pSkips[before - 1].prev, size);
+    }
+    while (from.index < limit && from.value < target) {
+        ++from;
+    }
+    return from;
+}
+
+// Implements: const_iterator begin() const;
+// begin: Iterator at first element
+IntList::const_iterator IntList::begin() const {
+    return const_iterator(data(), 0, 0, size);
+}
+
+// Implements: const_iterator end() const;
+// end: Iterator past last element
+IntList::const_iterator IntList::end() const {
+    return const_iterator(nullptr, size, 0, size);
+}
+
+// Implements: size_t bytesUsed() const;
+// bytesUsed: Encoded bytes plus stored checkpoints
+size_t IntList::bytesUsed() const {
+    size_t checkpoints = (size > 0) ? (size - 1) / skipInterval : 0;
+    return used + checkpoints * sizeof(SkipEntry);
+}
+
+// Implements: size_t bytesReserved() const;
+// bytesReserved: Heap bytes held (inline and borrowed storage cost nothing extra)
+size_t IntList::bytesReserved() const {
+    if (capacity == 0) {
+        return 0;
+    }
+    size_t reserved = (capacity > inlineBytes) ? capacity : 0;
+    if (pSkips) {
+        reserved += skipCapacity((size - 1) / skipInterval) * sizeof(SkipEntry);
+    }
+    return reserved;
+}
+
+// Implements: void shrinkToFit();
+// shrinkToFit: Move heap bytes to an exact-size array, or back inline if they fit; inline and
+// borrowed bytes are left alone (checkpoint capacity follows the count and is kept)
+void IntList::shrinkToFit() {
+    if (capacity <= inlineBytes || capacity == used) {
+        return;
+    }
+    unsigned char* heap = pData;
+    if (used <= inlineBytes) {
+        std::memcpy(inlineData, heap, used);
+        capacity = inlineBytes;
+    } else {
+        unsigned char* newData = new unsigned char[used];
+        std::memcpy(newData, heap, used);
+        pData = newData;
+        capacity = used;
+    }
+    delete[] heap;
+}
+
+// Implements: Encoded encoded() const;
+// encoded: Raw bytes and checkpoints, valid until the list changes
+IntList::Encoded IntList::encoded() const {
+    Encoded encoding;
+    encoding.bytes = data();
+    encoding.byteCount = used;
+    encoding.count = size;
+    encoding.last = last;
+    encoding.checkpoints = pSkips;
+    return encoding;
+}
+
+// Implements: static IntList borrow(const Encoded& encoding);
+// borrow: Wrap external bytes and checkpoints without copying (capacity = 0)
+IntList IntList::borrow(const Encoded& encoding) {
+    IntList list;
+    list.pData = const_cast<unsigned char*>(encoding.bytes);
+    list.pSkips = (checkpointCount(encoding.count) > 0)
+        ? static_cast<SkipEntry*>(const_cast<void*>(encoding.checkpoints)) : nullptr;
+    list.size = encoding.count;
+    list.used = encoding.byteCount;
+    list.capacity = 0;
+    list.last = encoding.last;
+    return list;
+}
+
+// Implements: static size_t checkpointCount(size_t count);
+// checkpointCount: One checkpoint per 64 values after the first 64
+size_t IntList::checkpointCount(size_t count) {
+    return (count > 0) ? (count - 1) / skipInterval : 0;
+}
+
+// Implements: static size_t checkpointBytes();
+// checkpointBytes: Size of one (offset, prev) checkpoint
+size_t IntList::checkpointBytes() {
+    return sizeof(SkipEntry);
+}
+
+// Implements: const_iterator(const unsigned char* bytes, size_t index, int prev, size_t size);
+// const_iterator: Decode the value at index from bytes following prev
+IntList::const_iterator::const_iterator(const unsigned char* bytes, size_t index, int prev, size_t size)
+    : next(bytes), index(index), value(prev), size(size) {
+    if (index < size) {
+        value = decodeNext(next, prev);
+    }
+}
+
+// Implements: int operator*() const;
+// operator*: Current value
+int IntList::const_iterator::operator*() const {
+    return value;
+}
+
+// Implements: const_iterator& operator++();
+// operator++: Decode the next value
+IntList::const_iterator& IntList::const_iterator::operator++() {
+    ++index;
+    if (index < size) {
+        value = decodeNext(next, value);
+    }
+    return *this;
+}
+
+// Implements: bool operator==(const const_iterator& other) const;
+// operator==: Same position
+bool IntList::const_iterator::operator==(const const_iterator& other) const {
+    return index == other.index;
+}
+
+// Implements: bool operator!=(const const_iterator& other) const;
+// operator!=: Different position
+bool IntList::const_iterator::operator!=(const const_iterator& other) const {
+    return index != other.index;
+}
+
+// Implements: size_t position() const;
+// position: Index of the current value
+size_t IntList::const_iterator::position() const {
+    return index;
+}
@@ -1,5 +1,7 @@
 // TO-DO for IntList.h
-// Purpose: Declare the IntList class to manage a dynamic sequence of integers.
+// Purpose: Declare the IntList class to manage a dynamic sequence of integers, stored as a
+// compressed posting list: each value is the zigzag-encoded delta from the previous value,
+// written as a varint. Line numbers grow slowly, so most entries take a single byte.
 
 // 1. Set up include guard
 //    - Add header guard to prevent multiple inclusions.
@@ -10,12 +12,15 @@
 //    - Include <stdexcept> for std::out_of_range in getElementAt.
 
 // 3. Declare IntList class
-//    - Define private members: pData (int*), size (size_t), capacity (size_t).
-//    - Declare private helper: resize.
+//    - Define private members: pData (encoded bytes, stored inline while they fit in a pointer),
+//      pSkips (decode checkpoint every 64 values), size, used (bytes), capacity (bytes), last.
+//      capacity == 0 marks borrowed bytes and checkpoints that this list does not own.
+//    - Declare private helpers: resize, data, unborrow.
+//    - Declare nested const_iterator (forward) that decodes values in order.
 
 // 4. Declare constructors
 //    - Default constructor: Initializes empty state.
-//    - Copy constructor: Deep copy.
+//    - Copy constructor: Deep copy (a borrowed list's bytes are copied into owned storage).
 //    - Move constructor: Transfers ownership, leaves other empty (noexcept).
 
 // 5. Declare destructor
@@ -31,8 +36,17 @@
 //    - getSize (const): Returns number of elements.
 //    - isEmpty (const): Checks if size is 0.
 //    - isFull (const): Checks if size equals capacity.
-//    - print (const): Outputs list to ostream.
+//    - print (const): Outputs list to ostream, or to an OutputBuffer (fast path).
 //    - getElementAt (const): Returns element at index, throws std::out_of_range if invalid.
+//    - back (const): Returns the last element, throws std::out_of_range if empty.
+//    - begin/end (const): Iterators over the decoded values.
+//    - iteratorAt (const): Iterator at an index, decoded from the nearest checkpoint.
+//    - advanceTo (const): Skip forward to the first value >= target before a limit (values in that
+//      range must be sorted), galloping over the checkpoints so long skips decode few values.
+//    - bytesUsed/bytesReserved (const): Encoded size and allocated size in bytes.
+//    - shrinkToFit: Drop the slack left by doubling (the next append doubles again).
+//    - encoded (const) / borrow (static): Expose the raw encoding, or wrap bytes owned elsewhere
+//      (e.g. a mapped index file) without copying; the first append copies them to the heap.
 
 // 8. Close include guard
 
@@ -42,15 +56,61 @@
 #include <cstddef>
 #include <ostream>
 #include <stdexcept>
+#include "OutputBuffer.h"
 
 class IntList {
 private:
-    int* pData;         // Pointer to dynamic array of integers
-    size_t size;        // Number of elements stored
-    size_t capacity;    // Current allocated size of array
-    void resize();      // Private helper to resize array
+    static const unsigned int inlineBytes = sizeof(unsigned char*); // Bytes stored without allocating
+    static const unsigned int skipInterval = 64;    // Values between decode checkpoints
+
+    // Decode checkpoint: where value k * skipInterval starts and the value before it
+    struct SkipEntry {
+        unsigned int offset;
+        int prev;
+    };
+
+    union {
+        unsigned char* pData;                   // Pointer to encoded bytes (capacity > inlineBytes or 0)
+        unsigned char inlineData[sizeof(unsigned char*)]; // Encoded bytes while they fit
+    };
+    SkipEntry* pSkips;  // Checkpoints for values 64, 128, ... (nullptr below 65 values)
+    unsigned int size;  // Number of elements stored
+    unsigned int used;  // Encoded bytes in use
+    unsigned int capacity; // Encoded bytes available (0 while borrowed)
+    int last;           // Last appended value (delta base)
+    void resize();      // Private helper to resize byte array
+    void unborrow();    // Private helper to copy borrowed bytes and checkpoints to the heap
+    unsigned char* data();                  // Encoded bytes (inline or heap)
+    const unsigned char* data() const;
 
 public:
+    // Raw encoding: varint bytes plus checkpoints as (offset, prev) pairs of 32-bit integers
+    struct Encoded {
+        const unsigned char* bytes;     // Encoded values
+        unsigned int byteCount;         // Bytes in use
+        unsigned int count;             // Number of values
+        int last;                       // Last value
+        const void* checkpoints;        // (count - 1) / 64 checkpoints, 4-byte aligned
+    };
+
+    // Forward iterator decoding one value per step
+    class const_iterator {
+    private:
+        const unsigned char* next;  // Next encoded byte
+        size_t index;               // Position of value
+        int value;                  // Current decoded value
+        size_t size;                // Number of elements in the list
+        const_iterator(const unsigned char* bytes, size_t index, int prev, size_t size);
+        friend class IntList;
+
+    public:
+        int operator*() const;                      // Current value
+        const_iterator& operator++();               // Decode the next value
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+        size_t position() const;                    // Index of the current value
+    };
+
     // Constructors
     IntList();                              // Default constructor: Empty state
     IntList(const IntList& other);          // Copy constructor: Deep copy
@@ -68,9 +128,22 @@ public:
     void clear();                                   // Remove all elements, deallocate
     size_t getSize() const;                         // Return number of elements
     bool isEmpty() const;                           // Check if size is 0
-    bool isFull() const;                            // Check if size equals capacity
+    bool isFull() const;                            // Check if the next append may need to resize
     void print(std::ostream& os) const;             // Output list to stream
+    void print(OutputBuffer& out) const;            // Append list to output buffer
     int getElementAt(size_t index) const;           // Get element at index, throw if invalid
+    int back() const;                               // Get last element, throw if empty
+    const_iterator begin() const;                   // Iterator at first element
+    const_iterator end() const;                     // Iterator past last element
+    const_iterator iteratorAt(size_t index) const;  // Iterator at index (end() if past the last)
+    const_iterator advanceTo(const_iterator from, size_t limit, int target) const; // First value >= target in [from, limit)
+    size_t bytesUsed() const;                       // Encoded bytes (plus checkpoints)
+    size_t bytesReserved() const;                   // Allocated bytes
+    void shrinkToFit();                             // Reallocate heap bytes to exactly bytes in use
+    Encoded encoded() const;                        // Raw encoding (valid until the next change)
+    static IntList borrow(const Encoded& encoding); // Wrap bytes owned elsewhere without copying
+    static size_t checkpointCount(size_t count);    // Checkpoints stored for count values
+    static size_t checkpointBytes();                // Size of one checkpoint
 };
 
 #endif // INTLIST_H
\ No newline at end of file
@@ -0,0 +1,94 @@
+// Normalizer.cpp
+// Purpose: Implement ingest-time token normalization (case folding, edge punctuation).
+
+#include "Normalizer.h"
+#include <cstring>
+
+namespace {
+
+// Check if byte c is an ASCII capital
+inline bool isUpperAscii(unsigned char c) {
+    return static_cast<unsigned char>(c - 'A') < 26;
+}
+
+// Check if bytes (0xC3, c) encode a Latin-1 capital U+00C0-U+00DE other than U+00D7 (multiplication sign)
+inline bool isUpperLatin1(unsigned char c) {
+    return c >= 0x80 && c <= 0x9E && c != 0x97;
+}
+
+} // namespace
+
+// Implements: explicit Normalizer(unsigned mode);
+// Constructor: Normalize with the given flags
+Normalizer::Normalizer(unsigned mode) : mode(mode) {}
+
+// Implements: void setMode(unsigned mode);
+// setMode: Set the Mode flags
+void Normalizer::setMode(unsigned newMode) {
+    mode = newMode;
+}
+
+// Implements: unsigned getMode() const;
+// getMode: Current Mode flags
+unsigned Normalizer::getMode() const {
+    return mode;
+}
+
+// Implements: bool isIdentity() const;
+// isIdentity: Check if no normalization is applied
+bool Normalizer::isIdentity() const {
+    return mode == none;
+}
+
+// Implements: static bool isPunctuation(char c);
+// isPunctuation: Same set as std::ispunct in the "C" locale
+bool Normalizer::isPunctuation(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return (u >= 0x21 && u <= 0x2F) || (u >= 0x3A && u <= 0x40) || (u >= 0x5B && u <= 0x60) ||
+           (u >= 0x7B && u <= 0x7E);
+}
+
+// Implements: size_t apply(const char*& text, size_t length);
+// apply: Trim edge punctuation by moving the view, then fold case into scratch only if some
+// byte actually changes, so already-normalized tokens are never copied
+size_t Normalizer::apply(const char*& text, size_t length) {
+    if (mode & stripPunctuation) {
+        size_t first = 0;
+        size_t last = length;
+        while (first < last && isPunctuation(text[first])) {
+            ++first;
+        }
+        while (last > first && isPunctuation(text[last - 1])) {
+            --last;
+        }
+        if (first < last) {
+            text += first;
+            length = last - first;
+        }
+    }
+    if (!(mode & foldCase)) {
+        return length;
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text);
+    size_t i = 0;
+    while (i < length && !isUpperAscii(bytes[i]) &&
+           !(bytes[i] == 0xC3 && i + 1 < length && isUpperLatin1(bytes[i + 1]))) {
+        ++i;
+    }
+    if (i == length) {
+        return length;
+    }
+    scratch.resize(length);
+    std::memcpy(scratch.data(), text, length);
+    for (; i < length; ++i) {
+        unsigned char c = bytes[i];
+        if (isUpperAscii(c)) {
+            scratch[i] = static_cast<char>(c + ('a' - 'A'));
+        } else if (c == 0xC3 && i + 1 < length && isUpperLatin1(bytes[i + 1])) {
+            scratch[i + 1] = static_cast<char>(bytes[i + 1] + 0x20);
+            ++i;
+        }
+    }
+    text = scratch.data();
+    return length;
+}
@@ -0,0 +1,47 @@
+// Normalizer.h
+// Purpose: Declare the Normalizer class, which maps a raw token to the form stored in the
+// index so that near-duplicates share one entry. Normalization runs once per token at
+// ingest (and once per query); stored tokens are already folded, so comparisons stay plain
+// byte compares. Modes combine as bit flags:
+//   foldCase          ASCII A-Z, plus the Latin-1 capitals U+00C0-U+00DE encoded in UTF-8,
+//                     are lowered; other bytes (including all other UTF-8) pass through intact.
+//   stripPunctuation  ASCII punctuation is removed from both ends ("(word)," -> "word");
+//                     inner punctuation ("don't", "e-mail") and tokens made only of
+//                     punctuation ("--") are kept.
+// Canonical Unicode composition (NFC) is not applied; tokens are compared as UTF-8 bytes.
+
+#ifndef NORMALIZER_H
+#define NORMALIZER_H
+
+#include <cstddef>
+#include <vector>
+
+class Normalizer {
+public:
+    // Bit flags for the mode
+    enum Mode : unsigned {
+        none = 0,
+        foldCase = 1,
+        stripPunctuation = 2
+    };
+
+private:
+    unsigned mode;              // Combination of Mode flags
+    std::vector<char> scratch;  // Folded bytes of the last token that needed rewriting
+
+public:
+    // Constructor
+    explicit Normalizer(unsigned mode = none);
+
+    // Public methods
+    void setMode(unsigned mode);    // Set the Mode flags
+    unsigned getMode() const;       // Current Mode flags
+    bool isIdentity() const;        // Check if tokens pass through unchanged
+    // Normalize [text, text + length): text is updated to the normalized bytes (the input
+    // itself when only trimming was needed, else scratch, valid until the next call) and
+    // the normalized length is returned
+    size_t apply(const char*& text, size_t length);
+    static bool isPunctuation(char c);  // ASCII punctuation (never a UTF-8 byte)
+};
+
+#endif // NORMALIZER_H
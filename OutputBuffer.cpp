@@ -0,0 +1,202 @@
+// OutputBuffer.cpp
+// Purpose: Implement the buffered output path (itoa formatting, large sink writes).
+
+#include "OutputBuffer.h"
+#include <cerrno>
+#include <unistd.h>
+
+// Implements: void reserve(size_t bytes);
+// Private helper: Flush to the sink when full, or grow an in-memory buffer
+void OutputBuffer::reserve(size_t bytes) {
+    if (capacity - used >= bytes) {
+        return;
+    }
+    if ((os || fd >= 0) && used > 0) {
+        drain();
+        if (capacity - used >= bytes) {
+            return;
+        }
+    }
+    size_t newCapacity = capacity ? capacity * 2 : 4096;
+    while (newCapacity - used < bytes) {
+        newCapacity *= 2;
+    }
+    char* newData = new char[newCapacity];
+    if (used > 0) {
+        std::memcpy(newData, data, used);
+    }
+    delete[] data;
+    data = newData;
+    capacity = newCapacity;
+}
+
+// Implements: void writeOut(const char* bytes, size_t n);
+// Private helper: Send bytes to the stream or descriptor, retrying short writes
+void OutputBuffer::writeOut(const char* bytes, size_t n) {
+    if (os) {
+        os->write(bytes, static_cast<std::streamsize>(n));
+        failed = failed || !*os;
+        return;
+    }
+    while (n > 0 && !failed) {
+        ssize_t written = ::write(fd, bytes, n);
+        if (written < 0) {
+            failed = (errno != EINTR);
+            continue;
+        }
+        bytes += written;
+        n -= static_cast<size_t>(written);
+    }
+}
+
+// Implements: void drain();
+// Private helper: Write buffered bytes to the sink and empty the buffer
+void OutputBuffer::drain() {
+    if ((os || fd >= 0) && used > 0) {
+        writeOut(data, used);
+        used = 0;
+    }
+}
+
+// Implements: OutputBuffer();
+// Default constructor: In-memory buffer, allocated on first append
+OutputBuffer::OutputBuffer()
+    : data(nullptr), used(0), capacity(0), os(nullptr), fd(-1), failed(false) {}
+
+// Implements: explicit OutputBuffer(std::ostream& os, size_t capacity);
+// Constructor: Buffer flushing to a stream
+OutputBuffer::OutputBuffer(std::ostream& os, size_t capacity)
+    : data(new char[capacity]), used(0), capacity(capacity), os(&os), fd(-1), failed(false) {}
+
+// Implements: explicit OutputBuffer(int fd, size_t capacity);
+// Constructor: Buffer flushing to a file descriptor
+OutputBuffer::OutputBuffer(int fd, size_t capacity)
+    : data(new char[capacity]), used(0), capacity(capacity), os(nullptr), fd(fd), failed(false) {}
+
+// Implements: OutputBuffer(OutputBuffer&& other) noexcept;
+// Move constructor: Transfer buffer and sink, leave other empty without a sink
+OutputBuffer::OutputBuffer(OutputBuffer&& other) noexcept
+    : data(other.data), used(other.used), capacity(other.capacity), os(other.os), fd(other.fd),
+      failed(other.failed) {
+    other.data = nullptr;
+    other.used = 0;
+    other.capacity = 0;
+    other.os = nullptr;
+    other.fd = -1;
+}
+
+// Implements: ~OutputBuffer();
+// Destructor: Flush to the sink, deallocate
+OutputBuffer::~OutputBuffer() {
+    flush();
+    delete[] data;
+}
+
+// Implements: OutputBuffer& operator=(OutputBuffer&& other) noexcept;
+// Move assignment: Flush own bytes, then transfer
+OutputBuffer& OutputBuffer::operator=(OutputBuffer&& other) noexcept {
+    if (this != &other) {
+        flush();
+        delete[] data;
+        data = other.data;
+        used = other.used;
+        capacity = other.capacity;
+        os = other.os;
+        fd = other.fd;
+        failed = other.failed;
+        other.data = nullptr;
+        other.used = 0;
+        other.capacity = 0;
+        other.os = nullptr;
+        other.fd = -1;
+    }
+    return *this;
+}
+
+// Implements: void append(const char* bytes, size_t n);
+// append: Copy into the buffer; blocks larger than the buffer go straight to the sink
+void OutputBuffer::append(const char* bytes, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    if (n > capacity - used && (os || fd >= 0) && n >= capacity) {
+        drain();
+        writeOut(bytes, n);
+        return;
+    }
+    reserve(n);
+    std::memcpy(data + used, bytes, n);
+    used += n;
+}
+
+// Implements: void append(char c);
+// append: One byte
+void OutputBuffer::append(char c) {
+    if (used == capacity) {
+        reserve(1);
+    }
+    data[used++] = c;
+}
+
+// Implements: void append(const OutputBuffer& other);
+// append: Bytes other has buffered
+void OutputBuffer::append(const OutputBuffer& other) {
+    append(other.data, other.used);
+}
+
+// Implements: void appendInt(long long value);
+// appendInt: Decimal digits written back to front into a small scratch array
+void OutputBuffer::appendInt(long long value) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* p = end;
+    unsigned long long v = (value < 0) ? 0ULL - static_cast<unsigned long long>(value)
+                                       : static_cast<unsigned long long>(value);
+    do {
+        *--p = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+    if (value < 0) {
+        *--p = '-';
+    }
+    size_t n = static_cast<size_t>(end - p);
+    if (capacity - used < n) {
+        reserve(n);
+    }
+    std::memcpy(data + used, p, n);
+    used += n;
+}
+
+// Implements: bool flush();
+// flush: Write buffered bytes to the sink and flush the stream (no-op for in-memory buffers)
+bool OutputBuffer::flush() {
+    drain();
+    if (os) {
+        os->flush();
+    }
+    return !failed;
+}
+
+// Implements: void clear();
+// clear: Drop buffered bytes, keep the allocation
+void OutputBuffer::clear() {
+    used = 0;
+}
+
+// Implements: const char* bytes() const;
+// bytes: Buffered bytes
+const char* OutputBuffer::bytes() const {
+    return data;
+}
+
+// Implements: size_t size() const;
+// size: Number of buffered bytes
+size_t OutputBuffer::size() const {
+    return used;
+}
+
+// Implements: bool good() const;
+// good: No sink write has failed
+bool OutputBuffer::good() const {
+    return !failed;
+}
@@ -0,0 +1,57 @@
+// OutputBuffer.h
+// Purpose: Declare the OutputBuffer class, the fast path for printing an index. Text and
+// integers are formatted into one large reusable buffer (integers with a hand-rolled itoa,
+// no locale or stream state) and handed to the sink in large writes. The sink is an
+// std::ostream, a file descriptor, or nothing: a buffer without a sink grows in memory so
+// its bytes can be emitted later (e.g. one buffer per section, rendered in parallel).
+
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+
+class OutputBuffer {
+private:
+    static const size_t defaultCapacity = 1 << 20;
+
+    char* data;             // Buffered bytes
+    size_t used;            // Bytes in data
+    size_t capacity;        // Allocated size of data
+    std::ostream* os;       // Stream sink (nullptr if none)
+    int fd;                 // Descriptor sink (-1 if none)
+    bool failed;            // A write to the sink failed
+    void reserve(size_t bytes);         // Private helper: make room, flushing or growing
+    void writeOut(const char* bytes, size_t n); // Private helper: send bytes to the sink
+    void drain();                       // Private helper: send buffered bytes, keep the stream unflushed
+
+public:
+    // Constructors
+    OutputBuffer();                                     // In-memory buffer (grows, no sink)
+    explicit OutputBuffer(std::ostream& os, size_t capacity = defaultCapacity); // Flush to os
+    explicit OutputBuffer(int fd, size_t capacity = defaultCapacity);           // Flush to fd
+    OutputBuffer(const OutputBuffer& other) = delete;   // Copy constructor: Deleted
+    OutputBuffer(OutputBuffer&& other) noexcept;        // Move constructor: Transfer buffer
+
+    // Destructor
+    ~OutputBuffer();                                    // Flush, deallocate
+
+    // Assignment operators
+    OutputBuffer& operator=(const OutputBuffer& other) = delete;
+    OutputBuffer& operator=(OutputBuffer&& other) noexcept;
+
+    // Public methods
+    void append(const char* bytes, size_t n);           // Append n bytes
+    void append(const char* str) { append(str, std::strlen(str)); } // Append a C-string
+    void append(char c);                                // Append one byte
+    void append(const OutputBuffer& other);             // Append another buffer's unflushed bytes
+    void appendInt(long long value);                    // Append value in decimal
+    bool flush();                                       // Write buffered bytes to the sink
+    void clear();                                       // Drop buffered bytes
+    const char* bytes() const;                          // Buffered bytes (in-memory use)
+    size_t size() const;                                // Number of buffered bytes
+    bool good() const;                                  // No sink write has failed
+};
+
+#endif // OUTPUTBUFFER_H
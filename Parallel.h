@@ -0,0 +1,66 @@
+// Parallel.h
+// Purpose: Declare parallelFor, a minimal fork-join helper used by the indexer to
+// spread independent work items (file chunks, sections) over a few std::threads.
+// Items are handed out dynamically, so uneven items still balance across workers.
+// An exception thrown by any item is rethrown on the calling thread after all
+// workers have joined. If a thread cannot be started, the items run on the threads
+// that could be, so the call still completes and every started thread is joined.
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Hardware threads available (at least 1)
+inline unsigned hardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// Call fn(i) for every i in [0, count) using up to threads threads (including the caller)
+template <typename Fn>
+void parallelFor(size_t count, unsigned threads, Fn fn) {
+    if (threads <= 1 || count <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    size_t workers = (threads < count) ? threads : count;
+    std::atomic<size_t> next(0);
+    std::vector<std::exception_ptr> errors(workers);
+    auto work = [&](size_t worker) {
+        try {
+            for (size_t i = next++; i < count; i = next++) {
+                fn(i);
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+            next = count; // Stop handing out items
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) {
+        try {
+            pool.emplace_back(work, w);
+        } catch (...) {
+            break; // No more threads (e.g. std::system_error): the started ones and the caller share the items
+        }
+    }
+    work(0);
+    for (size_t w = 0; w < pool.size(); ++w) {
+        pool[w].join();
+    }
+    for (size_t w = 0; w < workers; ++w) {
+        if (errors[w]) {
+            std::rethrow_exception(errors[w]);
+        }
+    }
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,460 @@
+// Query.cpp
+// Purpose: Implement Boolean line queries (parser, posting cursors, leapfrog intersection).
+
+#include "Query.h"
+#include "Indexer.h"
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <stdexcept>
+
+// Implements: explicit PostingCursor(const IndexedToken& token);
+// Constructor: Positioned at the token's first posting
+PostingCursor::PostingCursor(const IndexedToken& token)
+    : lines(&token.getLineNumbers()), runs(token.getDocumentRuns()), line(lines->begin()),
+      run(runs ? runs->begin() : lines->end()), runEnd(lines->getSize()), docId(0) {
+    if (runs && !done()) {
+        enterRun();
+    }
+}
+
+// Implements: void enterRun();
+// Private helper: Take the docId of the run starting at the current posting and find its end
+void PostingCursor::enterRun() {
+    while (run != runs->end() && static_cast<size_t>(*run) <= line.position()) {
+        ++run;
+        docId = *run;
+        ++run;
+    }
+    runEnd = (run != runs->end()) ? static_cast<size_t>(*run) : lines->getSize();
+}
+
+// Implements: bool done() const;
+// done: Check if all postings were consumed
+bool PostingCursor::done() const {
+    return line.position() >= lines->getSize();
+}
+
+// Implements: uint64_t key() const;
+// key: Current (docId, line) key
+uint64_t PostingCursor::key() const {
+    return makeKey(docId, *line);
+}
+
+// Implements: void next();
+// next: Skip repeats of the current line (a token seen twice on a line), then step
+void PostingCursor::next() {
+    uint64_t current = key();
+    do {
+        ++line;
+        if (runs && !done() && line.position() == runEnd) {
+            enterRun();
+        }
+    } while (!done() && key() == current);
+}
+
+// Implements: void advanceTo(uint64_t target);
+// advanceTo: Skip whole documents before target's document, then gallop within its run
+void PostingCursor::advanceTo(uint64_t target) {
+    if (done() || key() >= target) {
+        return;
+    }
+    int targetDoc = static_cast<int>(target >> 32);
+    int targetLine = static_cast<int>(static_cast<uint32_t>(target));
+    if (!runs) {
+        if (targetDoc > 0) {
+            line = lines->end();
+            return;
+        }
+    } else {
+        while (!done() && docId < targetDoc) {
+            line = lines->advanceTo(line, runEnd, INT_MAX);
+            if (!done()) {
+                enterRun();
+            }
+        }
+        if (done() || docId > targetDoc) {
+            return;
+        }
+    }
+    line = lines->advanceTo(line, runEnd, targetLine);
+    if (runs && !done() && line.position() == runEnd) {
+        enterRun();
+    }
+}
+
+// Implements: size_t estimate() const;
+// estimate: Number of postings
+size_t PostingCursor::estimate() const {
+    return lines->getSize();
+}
+
+// Implements: static uint64_t makeKey(int docId, int line);
+// makeKey: docId in the high half, line in the low half, so keys sort by (docId, line)
+uint64_t PostingCursor::makeKey(int docId, int line) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(docId)) << 32) | static_cast<uint32_t>(line);
+}
+
+namespace {
+
+// A sorted stream of distinct keys, the common shape of terms and their combinations
+class PostingStream {
+public:
+    virtual ~PostingStream() {}
+    virtual bool done() const = 0;
+    virtual uint64_t key() const = 0;
+    virtual void next() = 0;
+    virtual void advanceTo(uint64_t target) = 0;    // First key >= target
+    virtual size_t estimate() const = 0;            // Upper bound on remaining keys
+};
+
+typedef std::unique_ptr<PostingStream> StreamPtr;
+
+// A token missing from the index
+class EmptyStream : public PostingStream {
+public:
+    bool done() const { return true; }
+    uint64_t key() const { return 0; }
+    void next() {}
+    void advanceTo(uint64_t) {}
+    size_t estimate() const { return 0; }
+};
+
+// One token's postings
+class TermStream : public PostingStream {
+private:
+    PostingCursor cursor;
+
+public:
+    explicit TermStream(const IndexedToken& token) : cursor(token) {}
+    bool done() const { return cursor.done(); }
+    uint64_t key() const { return cursor.key(); }
+    void next() { cursor.next(); }
+    void advanceTo(uint64_t target) { cursor.advanceTo(target); }
+    size_t estimate() const { return cursor.estimate(); }
+};
+
+// Keys in every positive operand and in no negative one (leapfrog join)
+class AndStream : public PostingStream {
+private:
+    std::vector<StreamPtr> positives;   // Rarest first: it proposes candidates
+    std::vector<StreamPtr> negatives;
+    uint64_t current;
+    bool finished;
+
+    // Settle on the first key >= target that every positive holds and no negative does
+    void settle(uint64_t target) {
+        for (;;) {
+            bool agreed = true;
+            for (size_t i = 0; i < positives.size(); ++i) {
+                positives[i]->advanceTo(target);
+                if (positives[i]->done()) {
+                    finished = true;
+                    return;
+                }
+                if (positives[i]->key() > target) {
+                    target = positives[i]->key();
+                    agreed = false;
+                    break;
+                }
+            }
+            if (!agreed) {
+                continue;
+            }
+            bool excluded = false;
+            for (size_t i = 0; i < negatives.size() && !excluded; ++i) {
+                negatives[i]->advanceTo(target);
+                excluded = !negatives[i]->done() && negatives[i]->key() == target;
+            }
+            if (!excluded) {
+                current = target;
+                return;
+            }
+            ++target;
+        }
+    }
+
+public:
+    AndStream(std::vector<StreamPtr> pos, std::vector<StreamPtr> neg)
+        : positives(std::move(pos)), negatives(std::move(neg)), current(0), finished(false) {
+        std::sort(positives.begin(), positives.end(),
+                  [](const StreamPtr& a, const StreamPtr& b) { return a->estimate() < b->estimate(); });
+        settle(0);
+    }
+    bool done() const { return finished; }
+    uint64_t key() const { return current; }
+    void next() { settle(current + 1); }
+    void advanceTo(uint64_t target) {
+        if (!finished && target > current) {
+            settle(target);
+        }
+    }
+    size_t estimate() const { return positives.front()->estimate(); }
+};
+
+// Keys in any operand
+class OrStream : public PostingStream {
+private:
+    std::vector<StreamPtr> operands;
+    uint64_t current;
+    bool finished;
+
+    // Smallest key among the operands still running
+    void settle() {
+        finished = true;
+        for (size_t i = 0; i < operands.size(); ++i) {
+            if (!operands[i]->done() && (finished || operands[i]->key() < current)) {
+                current = operands[i]->key();
+                finished = false;
+            }
+        }
+    }
+
+public:
+    explicit OrStream(std::vector<StreamPtr> ops) : operands(std::move(ops)), current(0), finished(true) {
+        settle();
+    }
+    bool done() const { return finished; }
+    uint64_t key() const { return current; }
+    void next() {
+        for (size_t i = 0; i < operands.size(); ++i) {
+            if (!operands[i]->done() && operands[i]->key() == current) {
+                operands[i]->next();
+            }
+        }
+        settle();
+    }
+    void advanceTo(uint64_t target) {
+        if (finished || target <= current) {
+            return;
+        }
+        for (size_t i = 0; i < operands.size(); ++i) {
+            operands[i]->advanceTo(target);
+        }
+        settle();
+    }
+    size_t estimate() const {
+        size_t total = 0;
+        for (size_t i = 0; i < operands.size(); ++i) {
+            total += operands[i]->estimate();
+        }
+        return total;
+    }
+};
+
+// Parsed expression
+struct Node {
+    enum Kind { Term, And, Or, Not };
+    Kind kind;
+    std::string text;                           // Term text
+    std::vector<std::unique_ptr<Node> > children;
+    explicit Node(Kind k, const std::string& t = std::string()) : kind(k), text(t) {}
+};
+
+typedef std::unique_ptr<Node> NodePtr;
+
+// Recursive descent over words, quoted phrases, parentheses and the keywords AND, OR, NOT
+//   expr  := conj ( OR conj )*
+//   conj  := unary ( [AND] unary )*
+//   unary := NOT unary | '(' expr ')' | word | "word word ..."
+class Parser {
+private:
+    enum Kind { Word, Phrase, Open, Close, AndOp, OrOp, NotOp, End };
+    struct Lexeme {
+        Kind kind;
+        std::string text;
+    };
+    std::vector<Lexeme> lexemes;
+    size_t pos;
+
+    static bool isSpace(char c) {
+        return c == ' ' || (static_cast<unsigned char>(c - '\t') <= 4);
+    }
+
+    void lex(const std::string& s) {
+        size_t i = 0;
+        while (i < s.size()) {
+            char c = s[i];
+            if (isSpace(c)) {
+                ++i;
+            } else if (c == '(' || c == ')') {
+                Lexeme l = { c == '(' ? Open : Close, std::string() };
+                lexemes.push_back(l);
+                ++i;
+            } else if (c == '"') {
+                size_t close = s.find('"', i + 1);
+                if (close == std::string::npos) {
+                    throw std::invalid_argument("Unterminated quote in query");
+                }
+                Lexeme l = { Phrase, s.substr(i + 1, close - i - 1) };
+                lexemes.push_back(l);
+                i = close + 1;
+            } else {
+                size_t start = i;
+                while (i < s.size() && !isSpace(s[i]) && s[i] != '(' && s[i] != ')' && s[i] != '"') {
+                    ++i;
+                }
+                Lexeme l = { Word, s.substr(start, i - start) };
+                if (l.text == "AND") l.kind = AndOp;
+                else if (l.text == "OR") l.kind = OrOp;
+                else if (l.text == "NOT") l.kind = NotOp;
+                lexemes.push_back(l);
+            }
+        }
+        Lexeme end = { End, std::string() };
+        lexemes.push_back(end);
+    }
+
+    Kind peek() const { return lexemes[pos].kind; }
+
+    NodePtr expr() {
+        NodePtr first = conj();
+        if (peek() != OrOp) {
+            return first;
+        }
+        NodePtr node(new Node(Node::Or));
+        node->children.push_back(std::move(first));
+        while (peek() == OrOp) {
+            ++pos;
+            node->children.push_back(conj());
+        }
+        return node;
+    }
+
+    NodePtr conj() {
+        NodePtr first = unary();
+        Kind k = peek();
+        if (k != AndOp && k != Word && k != Phrase && k != Open && k != NotOp) {
+            return first;
+        }
+        NodePtr node(new Node(Node::And));
+        node->children.push_back(std::move(first));
+        for (k = peek(); k == AndOp || k == Word || k == Phrase || k == Open || k == NotOp; k = peek()) {
+            if (k == AndOp) {
+                ++pos;
+            }
+            node->children.push_back(unary());
+        }
+        return node;
+    }
+
+    NodePtr unary() {
+        const Lexeme& l = lexemes[pos];
+        switch (l.kind) {
+        case NotOp: {
+            ++pos;
+            NodePtr operand = unary();
+            if (operand->kind == Node::Not) {
+                return std::move(operand->children.front()); // NOT NOT x is x
+            }
+            NodePtr node(new Node(Node::Not));
+            node->children.push_back(std::move(operand));
+            return node;
+        }
+        case Open: {
+            ++pos;
+            NodePtr inner = expr();
+            if (peek() != Close) {
+                throw std::invalid_argument("Missing ) in query");
+            }
+            ++pos;
+            return inner;
+        }
+        case Word:
+            ++pos;
+            return NodePtr(new Node(Node::Term, l.text));
+        case Phrase: {
+            ++pos;
+            // All words of the phrase on one line
+            NodePtr node(new Node(Node::And));
+            size_t i = 0;
+            while (i < l.text.size()) {
+                while (i < l.text.size() && isSpace(l.text[i])) {
+                    ++i;
+                }
+                size_t start = i;
+                while (i < l.text.size() && !isSpace(l.text[i])) {
+                    ++i;
+                }
+                if (i > start) {
+                    node->children.push_back(NodePtr(new Node(Node::Term, l.text.substr(start, i - start))));
+                }
+            }
+            if (node->children.empty()) {
+                throw std::invalid_argument("Empty phrase in query");
+            }
+            return node;
+        }
+        default:
+            throw std::invalid_argument(l.kind == End ? "Query ends where a term was expected"
+                                                      : "Unexpected operator in query");
+        }
+    }
+
+public:
+    explicit Parser(const std::string& expression) : pos(0) {
+        lex(expression);
+    }
+
+    NodePtr parse() {
+        NodePtr root = expr();
+        if (peek() != End) {
+            throw std::invalid_argument("Unexpected ) in query");
+        }
+        return root;
+    }
+};
+
+// Build the stream for a parsed node
+StreamPtr compile(const Indexer& index, const Node& node) {
+    switch (node.kind) {
+    case Node::Term: {
+        const IndexedToken* token = index.find(node.text);
+        return token ? StreamPtr(new TermStream(*token)) : StreamPtr(new EmptyStream());
+    }
+    case Node::And: {
+        std::vector<StreamPtr> positives;
+        std::vector<StreamPtr> negatives;
+        for (size_t i = 0; i < node.children.size(); ++i) {
+            const Node& child = *node.children[i];
+            if (child.kind == Node::Not) {
+                negatives.push_back(compile(index, *child.children.front()));
+            } else {
+                positives.push_back(compile(index, child));
+            }
+        }
+        if (positives.empty()) {
+            throw std::invalid_argument("NOT needs a positive term to filter (e.g. cat AND NOT dog)");
+        }
+        if (positives.size() == 1 && negatives.empty()) {
+            return std::move(positives.front());
+        }
+        return StreamPtr(new AndStream(std::move(positives), std::move(negatives)));
+    }
+    case Node::Or: {
+        std::vector<StreamPtr> operands;
+        for (size_t i = 0; i < node.children.size(); ++i) {
+            operands.push_back(compile(index, *node.children[i]));
+        }
+        return StreamPtr(new OrStream(std::move(operands)));
+    }
+    default:
+        throw std::invalid_argument("NOT needs a positive term to filter (e.g. cat AND NOT dog)");
+    }
+}
+
+} // namespace
+
+// Implements: static std::vector<LineHit> evaluate(const Indexer& index, const std::string& expression);
+// evaluate: Parse, compile to posting streams and collect every key of the root stream
+std::vector<LineHit> Query::evaluate(const Indexer& index, const std::string& expression) {
+    NodePtr root = Parser(expression).parse();
+    StreamPtr stream = compile(index, *root);
+    std::vector<LineHit> hits;
+    for (; !stream->done(); stream->next()) {
+        uint64_t key = stream->key();
+        LineHit hit = { static_cast<int>(key >> 32), static_cast<int>(static_cast<uint32_t>(key)) };
+        hits.push_back(hit);
+    }
+    return hits;
+}
@@ -0,0 +1,61 @@
+// Query.h
+// Purpose: Declare Boolean line queries over the index. An expression combines tokens with
+// AND, OR, NOT and parentheses; adjacent terms are ANDed, and a quoted "x y" asks for lines
+// holding all of its words. The result is every (document, line) that satisfies it.
+//
+// Each term is read through a PostingCursor, a sorted stream of distinct (docId, line) keys
+// over the token's compressed posting list. Conjunctions leapfrog: the rarest operand
+// proposes a key and the others skip to it with IntList::advanceTo, which gallops over the
+// list's checkpoints, so "rare AND frequent" costs about the rare term's size times a
+// logarithm, however many postings the frequent term has. NOT is only allowed inside a
+// conjunction with a positive term ("x AND NOT y"), where it filters candidates the same way.
+
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "IndexedToken.h"
+#include "IntList.h"
+
+class Indexer;
+
+// One matching line (docId is 0 outside corpus mode)
+struct LineHit {
+    int docId;
+    int line;
+};
+
+// Distinct (docId, line) keys of one token in increasing order
+class PostingCursor {
+private:
+    const IntList* lines;               // Line postings
+    const IntList* runs;                // (first posting index, docId) pairs, nullptr outside corpus mode
+    IntList::const_iterator line;       // Current posting
+    IntList::const_iterator run;        // Next run pair (corpus mode)
+    size_t runEnd;                      // Index where the current document's postings end
+    int docId;                          // Document of the current posting
+    void enterRun();                    // Private helper: start the document run at the current posting
+
+public:
+    // Constructor
+    explicit PostingCursor(const IndexedToken& token);
+
+    // Public methods
+    bool done() const;                  // Check if all postings were consumed
+    uint64_t key() const;               // Current (docId, line) as docId << 32 | line
+    void next();                        // Move to the next distinct key
+    void advanceTo(uint64_t target);    // Move to the first key >= target
+    size_t estimate() const;            // Number of postings (upper bound on keys)
+    static uint64_t makeKey(int docId, int line);
+};
+
+class Query {
+public:
+    // Lines matching expression, in (docId, line) order; throws std::invalid_argument if malformed
+    static std::vector<LineHit> evaluate(const Indexer& index, const std::string& expression);
+};
+
+#endif // QUERY_H
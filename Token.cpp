@@ -1,33 +1,39 @@
 // TO-DO for Token.cpp
-// Purpose: Implement Token class member functions to manage a C-string token with manual memory management.
+// Purpose: Implement Token class member functions to manage a C-string token that is either
+// a heap copy (owned) or a view into an index's Arena.
 
 // 1. Include header file
 //    - Include Token.h to access the class declaration.
 
 // 2. Create a private helper function (optional)
-//    - Define a helper function to allocate and copy a C-string, handling null or empty inputs by creating a 1-byte array with a null terminator.
+//    - Define a helper function to allocate and copy len bytes plus a null terminator.
+//    - Empty tokens point at a shared empty literal and are not owned, so they never allocate.
 
 // 3. Implement default constructor
-//    - Allocate a 1-byte array for text and set it to a null terminator ('\0') for an empty token.
+//    - Point text at the shared empty string.
 
 // 4. Implement parameterized constructor
 //    - Allocate memory for text and deep copy the input C-string, handling null or empty inputs by creating an empty token.
+//    - (const char*, size_t) overload: copy exactly len bytes and add the null terminator.
+//    - (const char*, size_t, Arena&) overload: copy into the arena, not owned.
+//    - view: wrap text that is already null-terminated at len, not owned, no copy.
 
 // 5. Implement copy constructor
-//    - Allocate new memory for text and deep copy the other Token’s C-string.
+//    - Deep copy any non-empty Token, views included, so the copy does not depend on the source's
+//      arena or mapped file; code that means to share arena text uses view.
 
 // 6. Implement move constructor
-//    - Transfer ownership of the other Token’s text, then allocate a new 1-byte array with a null terminator for the moved-from object.
+//    - Transfer the other Token’s text, then point the moved-from object at the shared empty string.
 //    - Mark as noexcept.
 
 // 7. Implement destructor
-//    - Deallocate text using array deletion.
+//    - Deallocate text using array deletion if owned.
 
 // 8. Implement copy assignment operator
-//    - Check for self-assignment, deallocate existing text, allocate new memory, and deep copy the other Token’s C-string.
+//    - Check for self-assignment, release existing text, then copy as in the copy constructor.
 
 // 9. Implement move assignment operator
-//    - Check for self-assignment, deallocate existing text, transfer ownership of the other Token’s text, and set the moved-from object to an empty token.
+//    - Check for self-assignment, release existing text, transfer the other Token’s text, and set the moved-from object to an empty token.
 //    - Mark as noexcept.
 
 // 10. Implement getFirstChar
@@ -38,91 +44,139 @@
 //     - Return text as a const C-string.
 //     - Mark as const.
 
-// 12. Implement length
-//     - Return the length of text using a <cstring> function.
+// 12. Implement length and isOwned
+//     - Return the stored length / whether text was allocated by this token.
 //     - Mark as const.
 
 // 13. Implement print
 //     - Write text to the provided ostream.
+//     - OutputBuffer overload: append the bytes.
 //     - Mark as const.
 
 // 14. Implement compare (with Token)
-//     - Perform case-sensitive comparison with another Token’s text using a <cstring> function.
+//     - Perform case-sensitive comparison with another Token’s text using memcmp and the stored lengths.
 //     - Return an integer (<0, 0, or >0).
 //     - Mark as const.
+//     - (const char*, size_t) overload: same ordering as strcmp against the view.
 
 // 15. Implement compare (with C-string)
 //     - Perform case-sensitive comparison with a C-string using a <cstring> function, handling null input as an empty string.
 //     - Return an integer (<0, 0, or >0).
 //     - Mark as const.
+//     - (const char*, size_t) overload: same ordering as strcmp against the view.
 
 #include "Token.h"
+#include "Instrument.h"
 
-// Private helper: Allocates and copies a C-string, handling null/empty cases
-// Note: This is a helper function, not declared in Token.h
-char* Token::allocateText(const char* str) {
-    if (str == nullptr || str[0] == '\0') {
-        char* newText = new char[1];
-        newText[0] = '\0';
-        return newText;
+namespace {
+// Shared text of every empty token
+const char emptyText[1] = { '\0' };
+}
+
+// Private helper: Allocates and copies len bytes of a view, adding the terminator
+char* Token::allocateText(const char* str, size_t len) {
+    char* newText = new char[len + 1];
+    INDEXER_COUNT(tokenAllocations, 1);
+    INDEXER_COUNT(tokenBytesAllocated, len + 1);
+    if (len > 0) {
+        memcpy(newText, str, len);
     }
-    size_t len = strlen(str) + 1;
-    char* newText = new char[len];
-    strcpy(newText, str);
+    newText[len] = '\0';
     return newText;
 }
 
 // Implements: Token();
 // Default Constructor: Empty token
-Token::Token() {
-    text = new char[1];
-    text[0] = '\0';
-}
+Token::Token() : text(emptyText), len(0), owned(false) {}
 
 // Implements: Token(const char* str = "");
 // Parameterized Constructor: Deep copy of input string
-Token::Token(const char* str) {
-    text = allocateText(str);
+Token::Token(const char* str) : text(emptyText), len(0), owned(false) {
+    if (str != nullptr && str[0] != '\0') {
+        len = strlen(str);
+        text = allocateText(str, len);
+        owned = true;
+    }
+}
+
+// Implements: Token(const char* str, size_t len);
+// Parameterized Constructor: Deep copy of a non-terminated view
+Token::Token(const char* str, size_t len) : text(emptyText), len(len), owned(false) {
+    if (len > 0) {
+        text = allocateText(str, len);
+        owned = true;
+    }
+}
+
+// Implements: Token(const char* str, size_t len, Arena& arena);
+// Parameterized Constructor: Copy of a view stored in arena, not owned
+Token::Token(const char* str, size_t len, Arena& arena)
+    : text(len > 0 ? arena.copyString(str, len) : emptyText), len(len), owned(false) {}
+
+// Implements: static Token view(const char* str, size_t len);
+// view: Share null-terminated text owned elsewhere, not owned
+Token Token::view(const char* str, size_t len) {
+    Token token(emptyText, 0);
+    if (len > 0) {
+        token.text = str;
+        token.len = len;
+    }
+    return token;
 }
 
 // Implements: Token(const Token& other);
-// Copy Constructor: Deep copy of other.text
-Token::Token(const Token& other) {
-    text = allocateText(other.text);
+// Copy Constructor: Deep copy of the text, whoever owns it (empty tokens share emptyText)
+Token::Token(const Token& other) : text(emptyText), len(other.len), owned(false) {
+    if (len > 0) {
+        text = allocateText(other.text, len);
+        owned = true;
+    }
 }
 
 // Implements: Token(Token&& other) noexcept;
-// Move Constructor: Transfer ownership, leave other empty
-Token::Token(Token&& other) noexcept {
-    text = other.text;
-    other.text = new char[1];
-    other.text[0] = '\0';
+// Move Constructor: Transfer text, leave other empty
+Token::Token(Token&& other) noexcept : text(other.text), len(other.len), owned(other.owned) {
+    other.text = emptyText;
+    other.len = 0;
+    other.owned = false;
 }
 
 // Implements: ~Token();
-// Destructor: Deallocate text
+// Destructor: Deallocate text if owned
 Token::~Token() {
-    delete[] text;
+    if (owned) {
+        delete[] text;
+    }
 }
 
 // Implements: Token& operator=(const Token& other);
 // Copy Assignment Operator: Deep copy, handle self-assignment
 Token& Token::operator=(const Token& other) {
     if (this != &other) {
-        delete[] text; // Deallocate current text
-        text = allocateText(other.text);
+        const char* newText = other.len > 0 ? allocateText(other.text, other.len) : emptyText;
+        if (owned) {
+            delete[] text; // Deallocate current text
+        }
+        text = newText;
+        len = other.len;
+        owned = len > 0;
     }
     return *this;
 }
 
 // Implements: Token& operator=(Token&& other) noexcept;
-// Move Assignment Operator: Transfer ownership, handle self-assignment
+// Move Assignment Operator: Transfer text, handle self-assignment
 Token& Token::operator=(Token&& other) noexcept {
     if (this != &other) {
-        delete[] text; // Deallocate current text
-        text = other.text; // Transfer text ownership
-        other.text = new char[1];
-        other.text[0] = '\0';
+        if (owned) {
+            delete[] text; // Deallocate current text
+        }
+        text = other.text; // Transfer text
+        len = other.len;
+        owned = other.owned;
+        other.text = emptyText;
+        other.len = 0;
+        other.owned = false;
     }
     return *this;
 }
@@ -140,25 +194,48 @@ const char* Token::c_str() const {
 }
 
 // Implements: size_t length() const;
-// length: Return length of text
+// length: Return stored length of text
 size_t Token::length() const {
-    return strlen(text);
+    return len;
+}
+
+// Implements: bool isOwned() const;
+// isOwned: Check if text is a heap copy owned by this token
+bool Token::isOwned() const {
+    return owned;
 }
 
 // Implements: void print(std::ostream& os) const;
 // print: Write text to output stream
 void Token::print(std::ostream& os) const {
-    os << text;
+    os.write(text, static_cast<std::streamsize>(len));
+}
+
+// Implements: void print(OutputBuffer& out) const;
+// print: Append text to output buffer
+void Token::print(OutputBuffer& out) const {
+    out.append(text, len);
 }
 
 // Implements: int compare(const Token& other) const;
 // compare (with Token): Case-sensitive comparison
 int Token::compare(const Token& other) const {
-    return strcmp(text, other.text);
+    return compare(other.text, other.len);
 }
 
 // Implements: int compare(const char* str) const;
 // compare (with C-string): Case-sensitive comparison
 int Token::compare(const char* str) const {
     return strcmp(text, str ? str : "");
-}
\ No newline at end of file
+}
+
+// Implements: int compare(const char* str, size_t len) const;
+// compare (with view): Case-sensitive, ordered like strcmp (memcmp, then shorter first)
+int Token::compare(const char* str, size_t len) const {
+    size_t common = (this->len < len) ? this->len : len;
+    int result = (common > 0) ? memcmp(text, str, common) : 0;
+    if (result != 0) {
+        return result;
+    }
+    return (this->len < len) ? -1 : (this->len > len ? 1 : 0);
+}
@@ -1,5 +1,6 @@
 // TO-DO for Token.h
-// Purpose: Declare the Token class to represent a lexical token as a null-terminated C-string.
+// Purpose: Declare the Token class to represent a lexical token as a (pointer, length) view
+// of a null-terminated C-string, either owned or stored in an index's Arena.
 
 // 1. Set up include guard
 //    - Add a header guard to prevent multiple inclusions.
@@ -10,28 +11,36 @@
 //    - Include <ostream> for output stream in print method.
 
 // 3. Declare Token class
-//    - Define a private member char* text to store the dynamically allocated C-string.
+//    - Define private members text (const char*), len (size_t) and owned (bool).
+//    - Owned tokens hold a heap copy; arena tokens are views into an Arena and never free.
 
 // 4. Declare constructors
 //    - Default constructor to create an empty token.
 //    - Parameterized constructor with const char* parameter (default to empty string) for initializing with a C-string.
-//    - Copy constructor to deep copy another Token.
-//    - Move constructor (marked noexcept) to transfer ownership.
+//    - Parameterized constructor with (const char*, size_t) for initializing from a non-terminated view.
+//    - Parameterized constructor with (const char*, size_t, Arena&) for storing the view's bytes in an arena.
+//    - Static view to wrap null-terminated text owned elsewhere (e.g. a mapped index file) without copying.
+//    - Copy constructor to copy another Token (always a heap copy, so it outlives any arena or mapped file;
+//      view shares text on purpose).
+//    - Move constructor (marked noexcept) to transfer ownership without allocating.
 
 // 5. Declare destructor
-//    - Declare a destructor to deallocate the C-string.
+//    - Declare a destructor to deallocate the C-string if owned.
 
 // 6. Declare assignment operators
-//    - Copy assignment operator to deep copy another Token.
-//    - Move assignment operator (marked noexcept) to transfer ownership.
+//    - Copy assignment operator to copy another Token (always a heap copy, as the copy constructor).
+//    - Move assignment operator (marked noexcept) to transfer ownership without allocating.
 
 // 7. Declare utility methods
 //    - getFirstChar (const) to return the first character of the token.
 //    - c_str (const) to return the C-string.
-//    - length (const) to return the string length.
+//    - length (const) to return the stored string length.
+//    - isOwned (const) to check if the text is a heap copy.
 //    - print (const) to output the token to an ostream.
+//    - print (const) to append the token to an OutputBuffer (fast path).
 //    - compare (const) to compare with another Token (case-sensitive).
 //    - compare (const) to compare with a C-string (case-sensitive).
+//    - compare (const) to compare with a (const char*, size_t) view (case-sensitive).
 
 // 8. Close include guard
 //    - End the header guard.
@@ -43,35 +52,45 @@
 #include <cstring>   // String functions: strlen, strcpy, strcmp
 #include <cctype>    // Character functions: isalpha, tolower
 #include <ostream>   // For std::ostream (used in print)
+#include "Arena.h"
+#include "OutputBuffer.h"
 
 // Declaring the Token class
 class Token {
 private:
-    // Declaring the private member char* text to store the dynamically allocated C-string
-    char* text;
-    char* allocateText(const char* str); 
+    // Declaring the private members: the C-string, its length, and whether it is a heap copy
+    const char* text;
+    size_t len;
+    bool owned;
+    char* allocateText(const char* str, size_t len);
 
 public:
     // Declaring constructors
     Token();                                // Constructor to create an empty token.
     Token(const char* str = "");            // Constructor with const char* parameter (default to empty string) for initializing with a C-string.
-    Token(const Token& other);              // Copy constructor to deep copy another Token.
+    Token(const char* str, size_t len);     // Constructor copying len bytes of a non-terminated view.
+    Token(const char* str, size_t len, Arena& arena); // Constructor storing the view's bytes in arena (not owned).
+    Token(const Token& other);              // Copy constructor (heap copy of the text, even of an arena or mapped view).
     Token(Token&& other) noexcept;          // Move constructor (marked noexcept) to transfer ownership.
+    static Token view(const char* str, size_t len); // View of null-terminated text that outlives the token (not owned).
 
     // Declare default destructor
     ~Token();
 
     // Declaring assignment operators
-    Token& operator=(const Token& other);   // Copy assignment operator to deep copy another Token.
+    Token& operator=(const Token& other);   // Copy assignment operator (heap copy of the text).
     Token& operator=(Token&& other) noexcept; // Move assignment operator (marked noexcept) to transfer ownership.
 
     // Declaring utility methods
     char getFirstChar() const;              // getFirstChar (const) to return the first character of the token.
     const char* c_str() const;              // c_str (const) to return the C-string.
     size_t length() const;                  // length (const) to return the string length.
+    bool isOwned() const;                   // isOwned (const) to check if the text is a heap copy (not an arena or mapped view).
     void print(std::ostream& os) const;     // print (const) to output the token to an ostream.
+    void print(OutputBuffer& out) const;    // print (const) to append the token to an OutputBuffer.
     int compare(const Token& other) const;  // compare (const) to compare with another Token (case-sensitive).
     int compare(const char* str) const;     // compare (const) to compare with a C-string (case-sensitive).
+    int compare(const char* str, size_t len) const; // compare (const) to compare with a view (case-sensitive, strcmp order).
 };
 
 #endif // TOKEN_H
\ No newline at end of file
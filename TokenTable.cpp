@@ -0,0 +1,142 @@
+// TokenTable.cpp
+// Purpose: Implement the open-addressing (linear probing) token hash table.
+
+#include "TokenTable.h"
+
+// Implements: void grow();
+// Private helper: Double capacity (starts at 16)
+void TokenTable::grow() {
+    rehash((capacity == 0) ? 16 : capacity * 2);
+}
+
+// Implements: void rehash(size_t newCapacity);
+// Private helper: Reinsert into newCapacity slots using cached hashes
+void TokenTable::rehash(size_t newCapacity) {
+    Slot* newSlots = new Slot[newCapacity];
+    for (size_t i = 0; i < newCapacity; ++i) {
+        newSlots[i].token = nullptr;
+    }
+    size_t mask = newCapacity - 1;
+    for (size_t i = 0; i < capacity; ++i) {
+        if (slots[i].token) {
+            size_t j = slots[i].hash & mask;
+            while (newSlots[j].token) {
+                j = (j + 1) & mask;
+            }
+            newSlots[j] = slots[i];
+        }
+    }
+    delete[] slots;
+    slots = newSlots;
+    capacity = newCapacity;
+}
+
+// Implements: TokenTable();
+// Default constructor: Empty table, no allocation until first insert
+TokenTable::TokenTable() : slots(nullptr), capacity(0), count(0) {}
+
+// Implements: TokenTable(TokenTable&& other) noexcept;
+// Move constructor: Transfer ownership, leave other empty
+TokenTable::TokenTable(TokenTable&& other) noexcept
+    : slots(other.slots), capacity(other.capacity), count(other.count) {
+    other.slots = nullptr;
+    other.capacity = 0;
+    other.count = 0;
+}
+
+// Implements: ~TokenTable();
+// Destructor: Deallocate slots (tokens are owned by the DLList)
+TokenTable::~TokenTable() {
+    delete[] slots;
+}
+
+// Implements: TokenTable& operator=(TokenTable&& other) noexcept;
+// Move assignment: Transfer ownership, handle self-assignment
+TokenTable& TokenTable::operator=(TokenTable&& other) noexcept {
+    if (this != &other) {
+        delete[] slots;
+        slots = other.slots;
+        capacity = other.capacity;
+        count = other.count;
+        other.slots = nullptr;
+        other.capacity = 0;
+        other.count = 0;
+    }
+    return *this;
+}
+
+// Implements: static size_t hash(const char* text, size_t length);
+// hash: 64-bit FNV-1a over the token bytes
+size_t TokenTable::hash(const char* text, size_t length) {
+    unsigned long long h = 14695981039346656037ULL;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    for (size_t i = 0; i < length; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(h);
+}
+
+// Implements: IndexedToken* find(const char* text, size_t length, size_t hash) const;
+// find: Probe from hash slot until the token or an empty slot is found
+IndexedToken* TokenTable::find(const char* text, size_t length, size_t hash) const {
+    if (count == 0) {
+        return nullptr;
+    }
+    size_t mask = capacity - 1;
+    for (size_t i = hash & mask; slots[i].token; i = (i + 1) & mask) {
+        if (slots[i].hash == hash && slots[i].token->compare(text, length) == 0) {
+            return slots[i].token;
+        }
+    }
+    return nullptr;
+}
+
+// Implements: void insert(IndexedToken* token, size_t hash);
+// insert: Place token in first free slot, grow at 70% load
+void TokenTable::insert(IndexedToken* token, size_t hash) {
+    if ((count + 1) * 10 > capacity * 7) {
+        grow();
+    }
+    size_t mask = capacity - 1;
+    size_t i = hash & mask;
+    while (slots[i].token) {
+        i = (i + 1) & mask;
+    }
+    slots[i].hash = hash;
+    slots[i].token = token;
+    ++count;
+}
+
+// Implements: void reserve(size_t entries);
+// reserve: Grow to the smallest power of two that keeps entries under 70% load
+void TokenTable::reserve(size_t entries) {
+    size_t newCapacity = (capacity == 0) ? 16 : capacity;
+    while (entries * 10 > newCapacity * 7) {
+        newCapacity *= 2;
+    }
+    if (newCapacity != capacity) {
+        rehash(newCapacity);
+    }
+}
+
+// Implements: void clear();
+// clear: Deallocate slots, reset to empty state
+void TokenTable::clear() {
+    delete[] slots;
+    slots = nullptr;
+    capacity = 0;
+    count = 0;
+}
+
+// Implements: size_t size() const;
+// size: Return number of entries
+size_t TokenTable::size() const {
+    return count;
+}
+
+// Implements: size_t bytesReserved() const;
+// bytesReserved: Allocated slots times slot size
+size_t TokenTable::bytesReserved() const {
+    return capacity * sizeof(Slot);
+}
@@ -0,0 +1,49 @@
+// TokenTable.h
+// Purpose: Declare the TokenTable class, an open-addressing hash table that interns
+// IndexedToken objects by their token bytes so repeated words are found in O(1).
+// The table does not own the tokens; it stores pointers into a section's DLList nodes.
+
+#ifndef TOKENTABLE_H
+#define TOKENTABLE_H
+
+#include <cstddef>
+#include "IndexedToken.h"
+
+class TokenTable {
+private:
+    // A slot is empty when token is nullptr
+    struct Slot {
+        size_t hash;            // Cached hash of the token bytes
+        IndexedToken* token;    // Interned token (not owned)
+    };
+
+    Slot* slots;                // Slot array, capacity is a power of two
+    size_t capacity;            // Number of slots
+    size_t count;               // Number of occupied slots
+    void grow();                // Private helper to double capacity and rehash
+    void rehash(size_t newCapacity); // Private helper to move entries into newCapacity slots
+
+public:
+    // Constructors
+    TokenTable();                                   // Default constructor: Empty table
+    TokenTable(const TokenTable& other) = delete;   // Copy constructor: Deleted (pointers are not portable)
+    TokenTable(TokenTable&& other) noexcept;        // Move constructor: Transfer ownership
+
+    // Destructor
+    ~TokenTable();
+
+    // Assignment operators
+    TokenTable& operator=(const TokenTable& other) = delete;    // Copy assignment: Deleted
+    TokenTable& operator=(TokenTable&& other) noexcept;         // Move assignment: Transfer ownership
+
+    // Public methods
+    static size_t hash(const char* text, size_t length);    // FNV-1a hash of a token view
+    IndexedToken* find(const char* text, size_t length, size_t hash) const; // Return interned token or nullptr
+    void insert(IndexedToken* token, size_t hash);          // Intern a token not already present
+    void reserve(size_t entries);                           // Grow once to hold entries without rehashing
+    void clear();                                           // Remove all entries, deallocate
+    size_t size() const;                                    // Return number of entries
+    size_t bytesReserved() const;                           // Bytes of the slot array
+};
+
+#endif // TOKENTABLE_H
@@ -0,0 +1,201 @@
+// Tokenizer.cpp
+// Purpose: Implement in-place whitespace tokenization with line tracking.
+
+#include "Tokenizer.h"
+#include <cstring>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#define TOKENIZER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Number of set bits (newlines) in a mask
+inline int popcount64(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    int n = 0;
+    for (; x; x &= x - 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// Index of the lowest set bit (x != 0)
+inline int lowestBit(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+#ifdef TOKENIZER_X86
+// SSE2: 16 bytes per compare; separator is ' ' or (byte - '\t') <= 4 unsigned
+void sse2Kernel(const char* block, uint64_t& sep, uint64_t& newline) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i four = _mm_set1_epi8(4);
+    const __m128i lf = _mm_set1_epi8('\n');
+    sep = 0;
+    newline = 0;
+    for (int i = 0; i < 64; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        __m128i ctl = _mm_sub_epi8(v, tab);
+        __m128i isCtl = _mm_cmpeq_epi8(_mm_min_epu8(ctl, four), ctl);
+        __m128i isSep = _mm_or_si128(isCtl, _mm_cmpeq_epi8(v, space));
+        sep |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(isSep))) << i;
+        newline |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, lf)))) << i;
+    }
+}
+
+// AVX2: same classification, 32 bytes per compare
+__attribute__((target("avx2")))
+void avx2Kernel(const char* block, uint64_t& sep, uint64_t& newline) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i four = _mm256_set1_epi8(4);
+    const __m256i lf = _mm256_set1_epi8('\n');
+    sep = 0;
+    newline = 0;
+    for (int i = 0; i < 64; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        __m256i ctl = _mm256_sub_epi8(v, tab);
+        __m256i isCtl = _mm256_cmpeq_epi8(_mm256_min_epu8(ctl, four), ctl);
+        __m256i isSep = _mm256_or_si256(isCtl, _mm256_cmpeq_epi8(v, space));
+        sep |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(isSep))) << i;
+        newline |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, lf)))) << i;
+    }
+}
+#endif
+
+} // namespace
+
+// Implements: Tokenizer(const char* begin, const char* end, int firstLine = 1);
+// Constructor: Scan [begin, end) starting at line firstLine
+Tokenizer::Tokenizer(const char* begin, const char* end, int firstLine)
+    : pos(begin), end(end), block(begin), pending(0), starts(0), newlines(0),
+      blockLine(firstLine), line(firstLine), prevSeparator(true),
+      tokenStart(nullptr), tokenLine(firstLine), kernel(selectKernel()) {}
+
+// Implements: static bool isSeparator(char c);
+// isSeparator: Same set as std::isspace in the "C" locale
+bool Tokenizer::isSeparator(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Implements: static void scalarKernel(const char* block, uint64_t& sep, uint64_t& newline);
+// scalarKernel: Portable byte-at-a-time classifier
+void Tokenizer::scalarKernel(const char* block, uint64_t& sep, uint64_t& newline) {
+    sep = 0;
+    newline = 0;
+    for (int i = 0; i < 64; ++i) {
+        sep |= static_cast<uint64_t>(isSeparator(block[i])) << i;
+        newline |= static_cast<uint64_t>(block[i] == '\n') << i;
+    }
+}
+
+// Implements: static MaskKernel selectKernel();
+// selectKernel: AVX2 if the CPU has it, else SSE2 on x86, else scalar
+Tokenizer::MaskKernel Tokenizer::selectKernel() {
+#ifdef TOKENIZER_X86
+    static const MaskKernel selected = __builtin_cpu_supports("avx2") ? avx2Kernel : sse2Kernel;
+    return selected;
+#else
+    return scalarKernel;
+#endif
+}
+
+// Implements: static const char* kernelName();
+// kernelName: Name of the selected kernel, for reports
+const char* Tokenizer::kernelName() {
+    MaskKernel k = selectKernel();
+#ifdef TOKENIZER_X86
+    if (k == avx2Kernel) {
+        return "avx2";
+    }
+    if (k == sse2Kernel) {
+        return "sse2";
+    }
+#endif
+    return k == scalarKernel ? "scalar" : "unknown";
+}
+
+// Implements: bool loadBlock();
+// Private helper: Classify the next 64 bytes (the tail is padded with separators)
+bool Tokenizer::loadBlock() {
+    if (pos >= end) {
+        if (prevSeparator) {
+            return false;
+        }
+        // Input ended on a block boundary inside a token: close it at end
+        block = end;
+        starts = 0;
+        pending = 1;
+        newlines = 0;
+        blockLine = line;
+        prevSeparator = true;
+        return true;
+    }
+    uint64_t sep;
+    size_t remaining = static_cast<size_t>(end - pos);
+    if (remaining >= 64) {
+        kernel(pos, sep, newlines);
+    } else {
+        char tail[64];
+        std::memcpy(tail, pos, remaining);
+        std::memset(tail + remaining, ' ', 64 - remaining);
+        kernel(tail, sep, newlines);
+        newlines &= (static_cast<uint64_t>(1) << remaining) - 1;
+    }
+    // A boundary is a change between separator and token bytes
+    uint64_t shifted = (sep << 1) | static_cast<uint64_t>(prevSeparator);
+    starts = ~sep & shifted;
+    pending = starts | (sep & ~shifted);
+    prevSeparator = (sep >> 63) != 0;
+    block = pos;
+    blockLine = line;
+    line += popcount64(newlines);
+    pos += (remaining >= 64) ? 64 : remaining;
+    return true;
+}
+
+// Implements: size_t next(TokenSpan* out, size_t maxSpans);
+// next: Walk boundary bits, opening tokens at starts and emitting spans at ends
+size_t Tokenizer::next(TokenSpan* out, size_t maxSpans) {
+    size_t count = 0;
+    while (count < maxSpans) {
+        if (pending == 0 && !loadBlock()) {
+            break;
+        }
+        while (pending != 0 && count < maxSpans) {
+            int bit = lowestBit(pending);
+            uint64_t mask = static_cast<uint64_t>(1) << bit;
+            pending &= pending - 1;
+            if (starts & mask) {
+                tokenStart = block + bit;
+                tokenLine = blockLine + popcount64(newlines & (mask - 1));
+            } else {
+                out[count].text = tokenStart;
+                out[count].length = static_cast<size_t>(block + bit - tokenStart);
+                out[count].line = tokenLine;
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+// Implements: int currentLine() const;
+// currentLine: Line number after the last scanned byte
+int Tokenizer::currentLine() const {
+    return line;
+}
@@ -0,0 +1,57 @@
+// Tokenizer.h
+// Purpose: Declare the Tokenizer class, which splits a line-aligned byte range into
+// whitespace-separated tokens in place. Tokens are returned as (pointer, length)
+// spans into the input with their line numbers, in batches. Separators are the
+// C-locale whitespace set used by operator>> (space, \t, \n, \v, \f, \r).
+//
+// The input is classified 64 bytes at a time into separator and newline bitmasks
+// by a SIMD kernel (AVX2 or SSE2 on x86, chosen at runtime, scalar elsewhere);
+// token boundaries are then read off the mask transitions.
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// A token view into the tokenizer's input
+struct TokenSpan {
+    const char* text;   // First byte of the token (not null-terminated)
+    size_t length;      // Number of bytes
+    int line;           // 1-based line number
+};
+
+class Tokenizer {
+public:
+    // Classifies 64 bytes: bit i of sep/newline is set if byte i is a separator/'\n'
+    typedef void (*MaskKernel)(const char* block, uint64_t& sep, uint64_t& newline);
+
+private:
+    const char* pos;        // Next block to classify
+    const char* end;        // One past the last byte
+    const char* block;      // Block whose boundaries are being emitted
+    uint64_t pending;       // Boundary bits of block not yet consumed
+    uint64_t starts;        // Token-start bits of block
+    uint64_t newlines;      // Newline bits of block
+    int blockLine;          // Line number at the start of block
+    int line;               // Line number after block
+    bool prevSeparator;     // Whether the byte before block is a separator
+    const char* tokenStart; // Start of the token still open, if any
+    int tokenLine;          // Line of the open token
+    MaskKernel kernel;      // Classifier selected for this CPU
+    bool loadBlock();       // Private helper: classify the next block
+
+public:
+    // Constructor
+    Tokenizer(const char* begin, const char* end, int firstLine = 1);
+
+    // Public methods
+    static bool isSeparator(char c);                // Check if c separates tokens
+    static MaskKernel selectKernel();               // Best kernel for this CPU (cached)
+    static const char* kernelName();                // "avx2", "sse2" or "scalar"
+    static void scalarKernel(const char* block, uint64_t& sep, uint64_t& newline);
+    size_t next(TokenSpan* out, size_t maxSpans);   // Fill up to maxSpans spans, 0 when done
+    int currentLine() const;                        // Line number after the last scanned byte
+};
+
+#endif // TOKENIZER_H
@@ -0,0 +1,735 @@
+// Benchmark.cpp
+// Purpose: Benchmark driver for the indexer. Generates (or reads) a corpus, then measures
+// tokenizer throughput, Indexer ingest, print, listByLength and section lookup latency,
+// save/load, and the DLList (including insertion orders), IntList and Token building blocks.
+// Results are written as one JSON object so runs can be compared between versions.
+// A counting operator new also checks how many allocations DLList copies and inserts make, and
+// a copied list is read after its source is gone; if a check fails the run exits with status 3
+// (--check runs only the checks).
+//
+// Usage: indexer_bench [--size BYTES[K|M|G]] [--vocab N] [--zipf S] [--words MIN:MAX]
+//                      [--seed N] [--threads N] [--queries N] [--input FILE]
+//                      [--corpus FILE] [--keep] [--check] [--out FILE]
+
+#include "CorpusGenerator.h"
+#include "../Indexer.h"
+#include "../DLList.h"
+#include "../IntList.h"
+#include "../Token.h"
+#include "../Arena.h"
+#include "../Tokenizer.h"
+#include "../FileReader.h"
+#include "../Parallel.h"
+#include <sys/resource.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Calls of the global operator new / new[] (all threads)
+std::atomic<uint64_t> allocationCount(0);
+
+// Count one allocation and take it from malloc
+void* countedMalloc(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+} // namespace
+
+// Counting replacements for the global allocation functions (new[] calls malloc directly, so
+// the compiler sees every free paired with a malloc)
+void* operator new(std::size_t size) {
+    return countedMalloc(size);
+}
+
+void* operator new[](std::size_t size) {
+    return countedMalloc(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Results are stored here so the optimizer cannot drop measured loops
+volatile uint64_t sink;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Peak resident set size of this process in bytes
+uint64_t peakRssBytes() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);          // Bytes on macOS
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;   // KiB on Linux
+#endif
+}
+
+// Discards everything written to it
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+};
+
+// Sends std::cout to a NullBuffer for its lifetime
+class SilenceCout {
+private:
+    NullBuffer discard;
+    std::streambuf* saved;
+
+public:
+    SilenceCout() : saved(std::cout.rdbuf(&discard)) {}
+    ~SilenceCout() { std::cout.rdbuf(saved); }
+};
+
+// Latency samples in nanoseconds
+struct Latency {
+    std::vector<double> samples;
+    void add(double ns) { samples.push_back(ns); }
+    double percentile(double p) {
+        if (samples.empty()) return 0;
+        std::sort(samples.begin(), samples.end());
+        size_t i = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+        return samples[i];
+    }
+    double mean() const {
+        double total = 0;
+        for (size_t i = 0; i < samples.size(); ++i) total += samples[i];
+        return samples.empty() ? 0 : total / samples.size();
+    }
+};
+
+// Minimal JSON object writer (keys in insertion order)
+class JsonWriter {
+private:
+    std::ostringstream out;
+    std::vector<bool> first;    // Per open object: no member written yet
+    void key(const char* name) {
+        if (!first.back()) out << ",";
+        first.back() = false;
+        out << "\n" << std::string(first.size() * 2, ' ') << "\"" << name << "\": ";
+    }
+
+public:
+    JsonWriter() { out << "{"; first.push_back(true); out.precision(6); }
+    void beginObject(const char* name) { key(name); out << "{"; first.push_back(true); }
+    void endObject() { first.pop_back(); out << "\n" << std::string(first.size() * 2, ' ') << "}"; }
+    void number(const char* name, double value) { key(name); out << value; }
+    void integer(const char* name, uint64_t value) { key(name); out << value; }
+    void string(const char* name, const std::string& value) {
+        key(name);
+        out << "\"";
+        for (size_t i = 0; i < value.size(); ++i) {
+            char c = value[i];
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+            else out << c;
+        }
+        out << "\"";
+    }
+    void latency(const char* name, Latency& samples) {
+        beginObject(name);
+        integer("samples", samples.samples.size());
+        number("mean_ns", samples.mean());
+        number("p50_ns", samples.percentile(0.50));
+        number("p99_ns", samples.percentile(0.99));
+        endObject();
+    }
+    std::string str() { return out.str() + "\n}\n"; }
+};
+
+struct Settings {
+    CorpusGenerator::Options corpus;
+    std::string input;          // Existing corpus (no generation)
+    std::string corpusFile;     // Where to write the generated corpus
+    std::string output;         // JSON destination ("" = stdout)
+    unsigned threads;
+    size_t queries;
+    bool keep;
+    bool checkOnly;             // Run the allocation check alone
+    Settings() : corpusFile("bench_corpus.txt"), threads(hardwareThreads()), queries(20000), keep(false),
+                 checkOnly(false) {}
+};
+
+bool parseSize(const std::string& text, uint64_t& value) {
+    char* end = nullptr;
+    double v = std::strtod(text.c_str(), &end);
+    if (end == text.c_str() || v < 0) return false;
+    std::string suffix(end);
+    if (suffix == "K" || suffix == "k") v *= 1024.0;
+    else if (suffix == "M" || suffix == "m") v *= 1024.0 * 1024.0;
+    else if (suffix == "G" || suffix == "g") v *= 1024.0 * 1024.0 * 1024.0;
+    else if (!suffix.empty()) return false;
+    value = static_cast<uint64_t>(v);
+    return true;
+}
+
+bool parseArgs(int argc, char* argv[], Settings& s) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        std::string value = hasValue ? argv[i + 1] : "";
+        uint64_t n = 0;
+        if (arg == "--keep") { s.keep = true; continue; }
+        if (arg == "--check") { s.checkOnly = true; continue; }
+        if (!hasValue) return false;
+        ++i;
+        if (arg == "--size" && parseSize(value, n)) s.corpus.bytes = n;
+        else if (arg == "--vocab" && parseSize(value, n) && n > 0) s.corpus.vocabulary = static_cast<size_t>(n);
+        else if (arg == "--zipf") s.corpus.zipf = std::atof(value.c_str());
+        else if (arg == "--words" && value.find(':') != std::string::npos) {
+            s.corpus.minWordsPerLine = static_cast<size_t>(std::atol(value.c_str()));
+            s.corpus.maxWordsPerLine = static_cast<size_t>(std::atol(value.c_str() + value.find(':') + 1));
+        }
+        else if (arg == "--seed" && parseSize(value, n)) s.corpus.seed = n;
+        else if (arg == "--threads" && parseSize(value, n)) s.threads = n == 0 ? hardwareThreads() : static_cast<unsigned>(n);
+        else if (arg == "--queries" && parseSize(value, n) && n > 0) s.queries = static_cast<size_t>(n);
+        else if (arg == "--input") s.input = value;
+        else if (arg == "--corpus") s.corpusFile = value;
+        else if (arg == "--out") s.output = value;
+        else return false;
+    }
+    return true;
+}
+
+// Tokenizer and its baselines over [begin, end)
+void benchTokenizer(JsonWriter& json, const char* name, const char* begin, const char* end) {
+    size_t bytes = static_cast<size_t>(end - begin);
+    json.beginObject(name);
+    json.integer("bytes", bytes);
+
+    // Classification kernels alone, 64 bytes at a time
+    Tokenizer::MaskKernel kernels[2] = { Tokenizer::selectKernel(), &Tokenizer::scalarKernel };
+    const char* kernelNames[2] = { "kernel_selected_gbps", "kernel_scalar_gbps" };
+    for (int k = 0; k < 2; ++k) {
+        uint64_t sep = 0, nl = 0, acc = 0;
+        Clock::time_point start = Clock::now();
+        const char* p = begin;
+        for (; p + 64 <= end; p += 64) {
+            kernels[k](p, sep, nl);
+            acc += sep ^ nl;
+        }
+        double s = secondsSince(start);
+        sink = acc;
+        json.number(kernelNames[k], s > 0 ? bytes / s / 1e9 : 0);
+    }
+    json.string("kernel_selected", Tokenizer::kernelName());
+
+    // Full tokenizer: spans and line numbers
+    size_t tokens = 0;
+    Clock::time_point start = Clock::now();
+    {
+        TokenSpan batch[256];
+        Tokenizer tokenizer(begin, end, 1);
+        size_t count;
+        while ((count = tokenizer.next(batch, 256)) > 0) tokens += count;
+    }
+    double tokenizerSeconds = secondsSince(start);
+
+    // Baseline: a line string per line plus stringstream >>, as the original processTextFile did
+    size_t baselineTokens = 0;
+    start = Clock::now();
+    {
+        std::string line, word;
+        for (const char* p = begin; p < end;) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            const char* lineEnd = nl ? nl : end;
+            line.assign(p, lineEnd);
+            std::stringstream ss(line);
+            while (ss >> word) ++baselineTokens;
+            p = lineEnd + 1;
+        }
+    }
+    double baselineSeconds = secondsSince(start);
+    json.integer("tokens", tokens);
+    json.number("tokenizer_seconds", tokenizerSeconds);
+    json.number("tokenizer_tokens_per_sec", tokenizerSeconds > 0 ? tokens / tokenizerSeconds : 0);
+    json.number("getline_stringstream_seconds", baselineSeconds);
+    json.number("getline_stringstream_tokens_per_sec", baselineSeconds > 0 ? baselineTokens / baselineSeconds : 0);
+    json.number("speedup", tokenizerSeconds > 0 ? baselineSeconds / tokenizerSeconds : 0);
+    json.integer("token_counts_match", tokens == baselineTokens ? 1 : 0);
+    json.endObject();
+}
+
+// Indexer ingest, print, queries, save/load
+void benchIndexer(JsonWriter& json, const Settings& settings, const std::string& corpus,
+                  uint64_t corpusBytes, const CorpusGenerator& generator) {
+    json.beginObject("indexer");
+    Indexer index;
+    std::vector<unsigned> threadCounts(1, 1);
+    if (settings.threads > 1) threadCounts.push_back(settings.threads);
+    for (size_t t = 0; t < threadCounts.size(); ++t) {
+        index.setThreadCount(threadCounts[t]);
+        Clock::time_point start = Clock::now();
+        index.processTextFile(corpus);
+        double s = secondsSince(start);
+        std::string name = "ingest_threads_" + std::to_string(threadCounts[t]);
+        json.beginObject(name.c_str());
+        json.number("seconds", s);
+        json.number("mb_per_sec", s > 0 ? corpusBytes / s / 1e6 : 0);
+        uint64_t postings = 0, distinct = 0;
+        for (char c = 'a'; c <= 'z' + 1; ++c) {
+            std::vector<const IndexedToken*> tokens = index.tokensInSection(c <= 'z' ? c : '*');
+            distinct += tokens.size();
+            for (size_t i = 0; i < tokens.size(); ++i) postings += tokens[i]->getLineNumbers().getSize();
+        }
+        json.integer("tokens", postings);
+        json.integer("distinct_tokens", distinct);
+        json.number("tokens_per_sec", s > 0 ? postings / s : 0);
+        json.endObject();
+    }
+    json.integer("peak_rss_after_ingest_bytes", peakRssBytes());
+
+    {
+        SilenceCout silence;
+        Clock::time_point start = Clock::now();
+        index.print(std::cout);
+        json.number("print_seconds", secondsSince(start));
+    }
+
+    Latency byLength, bySection, find, findMiss;
+    {
+        SilenceCout silence;
+        for (int round = 0; round < 5; ++round) {
+            for (size_t length = 1; length <= 20; ++length) {
+                Clock::time_point start = Clock::now();
+                index.listByLength(length);
+                byLength.add(secondsSince(start) * 1e9);
+            }
+            const char* sections = "abcdefghijklmnopqrstuvwxyz*";
+            for (const char* c = sections; *c; ++c) {
+                Clock::time_point start = Clock::now();
+                index.ViewBySection(*c);
+                bySection.add(secondsSince(start) * 1e9);
+            }
+        }
+    }
+    json.latency("list_by_length", byLength);
+    json.latency("view_by_section", bySection);
+
+    // Exact lookups: hits drawn uniformly from the vocabulary, misses never indexed
+    std::mt19937_64 rng(settings.corpus.seed);
+    std::uniform_int_distribution<size_t> rank(0, generator.vocabularySize() - 1);
+    size_t found = 0;
+    for (size_t i = 0; i < settings.queries; ++i) {
+        const std::string& word = generator.word(rank(rng));
+        Clock::time_point start = Clock::now();
+        found += index.find(word) != nullptr;
+        find.add(secondsSince(start) * 1e9);
+        std::string miss = word + "~";
+        start = Clock::now();
+        found += index.find(miss) != nullptr;
+        findMiss.add(secondsSince(start) * 1e9);
+    }
+    json.latency("find_hit", find);
+    json.latency("find_miss", findMiss);
+    json.integer("find_found", found);
+
+    std::string indexFile = corpus + ".idx";
+    Clock::time_point start = Clock::now();
+    bool saved = index.save(indexFile);
+    json.number("save_seconds", secondsSince(start));
+    if (saved) {
+        std::ifstream in(indexFile.c_str(), std::ios::binary | std::ios::ate);
+        json.integer("index_file_bytes", static_cast<uint64_t>(in.tellg()));
+        Indexer loaded;
+        start = Clock::now();
+        loaded.load(indexFile);
+        json.number("load_seconds", secondsSince(start));
+        start = Clock::now();
+        loaded.load(indexFile, false);
+        json.number("load_no_verify_seconds", secondsSince(start));
+    }
+    std::remove(indexFile.c_str());
+    json.endObject();
+}
+
+// DLList: sorted insertion at lowerBound positions (random order), then lookups.
+// Kept small: each positional insert shifts the node index.
+void benchDLList(JsonWriter& json, const CorpusGenerator& generator, size_t queries) {
+    size_t n = std::min<size_t>(generator.vocabularySize(), 20000);
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    std::mt19937_64 rng(7);
+    std::shuffle(order.begin(), order.end(), rng);
+    Arena arena;
+    DLList list;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        const std::string& w = generator.word(order[i]);
+        size_t pos = list.lowerBound(w.data(), w.size());
+        list.emplaceBefore(pos, w.data(), w.size(), 1, arena);
+    }
+    double insertSeconds = secondsSince(start);
+    size_t hits = 0;
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    start = Clock::now();
+    for (size_t i = 0; i < queries; ++i) {
+        const std::string& w = generator.word(order[pick(rng)]);
+        size_t pos = list.lowerBound(w.data(), w.size());
+        hits += pos < list.size() && list.getIndexedTokenAt(pos).compare(w.data(), w.size()) == 0;
+    }
+    double lookupSeconds = secondsSince(start);
+    json.beginObject("dllist");
+    json.integer("tokens", n);
+    json.number("sorted_insert_ns", insertSeconds / n * 1e9);
+    json.number("lower_bound_ns", lookupSeconds / queries * 1e9);
+    json.integer("lookup_hits", hits);
+    json.endObject();
+}
+
+// DLList positional access in sorted, reverse-sorted and random insertion orders. Every 64
+// inserts an iterator erase at the head leaves the node index stale, as iterator-editing callers
+// do, so positional inserts go through finger search (sorted and reverse stay near the tail or
+// head; random ones need lowerBound and rebuild the index). A positional sweep after an edit in
+// the middle of the list then measures near-sequential access.
+void benchDLListOrders(JsonWriter& json, const CorpusGenerator& generator) {
+    size_t n = std::min<size_t>(generator.vocabularySize(), 20000);
+    std::vector<const std::string*> words(n);
+    for (size_t i = 0; i < n; ++i) words[i] = &generator.word(i);
+    std::sort(words.begin(), words.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+    const char* names[] = {"sorted", "reverse", "random"};
+    json.beginObject("dllist_orders");
+    for (int order = 0; order < 3; ++order) {
+        std::vector<const std::string*> sequence(words);
+        if (order == 1) std::reverse(sequence.begin(), sequence.end());
+        if (order == 2) {
+            std::mt19937_64 rng(13);
+            std::shuffle(sequence.begin(), sequence.end(), rng);
+        }
+        Arena arena;
+        DLList list;
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            const std::string& w = *sequence[i];
+            size_t pos = order == 0 ? list.size() : order == 1 ? 0 : list.lowerBound(w.data(), w.size());
+            list.emplaceBefore(pos, w.data(), w.size(), 1, arena);
+            if (i % 64 == 63) list.erase(list.begin());
+        }
+        double insertSeconds = secondsSince(start);
+        DLList::iterator middle = list.begin();
+        for (size_t i = 0; i < list.size() / 2; ++i) ++middle;
+        list.insert_before(middle, "middle", 6, 1, arena);
+        uint64_t bytes = 0;
+        start = Clock::now();
+        for (size_t i = 0; i < list.size(); ++i) {
+            bytes += list.getIndexedTokenAt(i).getToken().length();
+        }
+        double sweepSeconds = secondsSince(start);
+        sink = bytes;
+        json.beginObject(names[order]);
+        json.integer("tokens", n);
+        json.number("insert_ns", insertSeconds / n * 1e9);
+        json.number("sweep_ns", sweepSeconds / list.size() * 1e9);
+        json.endObject();
+    }
+    json.endObject();
+}
+
+// IntList: append, sequential decode, random access, compression
+void benchIntList(JsonWriter& json) {
+    const size_t n = 10000000;
+    IntList list;
+    std::mt19937_64 rng(11);
+    std::geometric_distribution<int> gap(0.3);
+    Clock::time_point start = Clock::now();
+    int line = 1;
+    for (size_t i = 0; i < n; ++i) {
+        line += gap(rng);
+        list.append(line);
+    }
+    double appendSeconds = secondsSince(start);
+    start = Clock::now();
+    long long sum = 0;
+    for (IntList::const_iterator it = list.begin(); it != list.end(); ++it) sum += *it;
+    double iterateSeconds = secondsSince(start);
+    const size_t probes = 1000000;
+    std::uniform_int_distribution<size_t> index(0, n - 1);
+    start = Clock::now();
+    for (size_t i = 0; i < probes; ++i) sum += list.getElementAt(index(rng));
+    double randomSeconds = secondsSince(start);
+    json.beginObject("intlist");
+    json.integer("values", n);
+    json.number("append_ns", appendSeconds / n * 1e9);
+    json.number("iterate_ns", iterateSeconds / n * 1e9);
+    json.number("get_element_at_ns", randomSeconds / probes * 1e9);
+    json.number("bytes_per_value", static_cast<double>(list.bytesUsed()) / n);
+    sink = static_cast<uint64_t>(sum);
+    json.endObject();
+}
+
+// Token: arena construction and comparison
+void benchToken(JsonWriter& json, const CorpusGenerator& generator) {
+    size_t n = std::min<size_t>(generator.vocabularySize(), 1000000);
+    Arena arena;
+    std::vector<Token> tokens;
+    tokens.reserve(n);
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        const std::string& w = generator.word(i);
+        tokens.push_back(Token(w.data(), w.size(), arena));
+    }
+    double constructSeconds = secondsSince(start);
+    std::mt19937_64 rng(13);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    const size_t compares = 2000000;
+    long long acc = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < compares; ++i) acc += tokens[pick(rng)].compare(tokens[pick(rng)]) < 0;
+    double compareSeconds = secondsSince(start);
+    json.beginObject("token");
+    json.integer("tokens", n);
+    json.number("arena_construct_ns", constructSeconds / n * 1e9);
+    json.number("compare_ns", compareSeconds / compares * 1e9);
+    json.integer("arena_bytes", arena.bytesUsed());
+    sink = static_cast<uint64_t>(acc);
+    json.endObject();
+}
+
+// Allocations made by DLList copies and inserts, against fixed limits. Each entry of the source
+// list owns two heap blocks (token text and posting bytes), so a copy needs two allocations per
+// entry; a moved-in temporary needs only the one that built it, and an arena-backed emplace none.
+// The rest is pool blocks and nodeIndex growth. Returns false if a count is over its limit.
+bool benchAllocations(JsonWriter& json) {
+    const size_t n = 1000;
+    std::vector<std::string> words(n);
+    for (size_t i = 0; i < n; ++i) words[i] = "token" + std::to_string(i);
+    DLList source;
+    for (size_t i = 0; i < n; ++i) {
+        IndexedToken& entry = source.emplaceBefore(i, words[i].data(), words[i].size(), 1);
+        for (size_t line = 2; line <= 20; ++line) entry.appendLineNumber(line);
+    }
+    const char* names[3] = {"copy", "move_insert", "emplace_insert"};
+    const uint64_t limits[3] = {2 * n + 16, n + 32, 32};
+    uint64_t counts[3];
+
+    uint64_t before = allocationCount.load();
+    {
+        DLList copy(source);
+        counts[0] = allocationCount.load() - before;
+    }
+    {
+        DLList list;
+        before = allocationCount.load();
+        for (size_t i = 0; i < n; ++i) {
+            IndexedToken temporary(words[i].data(), words[i].size(), 1);
+            list.addBefore(std::move(temporary), i);
+        }
+        counts[1] = allocationCount.load() - before;
+    }
+    {
+        Arena arena;
+        DLList list;
+        before = allocationCount.load();
+        for (size_t i = 0; i < n; ++i) {
+            list.emplaceBefore(i, words[i].data(), words[i].size(), 1, arena);
+        }
+        counts[2] = allocationCount.load() - before;
+    }
+
+    bool ok = true;
+    json.beginObject("allocations");
+    json.integer("entries", n);
+    for (int i = 0; i < 3; ++i) {
+        std::string limit = std::string(names[i]) + "_limit";
+        json.integer(names[i], counts[i]);
+        json.integer(limit.c_str(), limits[i]);
+        if (counts[i] > limits[i]) {
+            std::cerr << "Error: DLList " << names[i] << " made " << counts[i]
+                      << " allocations (limit " << limits[i] << ")" << std::endl;
+            ok = false;
+        }
+    }
+    json.integer("within_limits", ok ? 1 : 0);
+    json.endObject();
+    return ok;
+}
+
+// Copies must not depend on their source: copy an arena-backed DLList, destroy the list and its
+// arena, reuse the freed memory, then read the copy; copy a token of a loaded (mapped) index
+// and read its postings after the index is gone. Returns false on a mismatch.
+bool benchCopies(JsonWriter& json) {
+    const size_t n = 1000;
+    std::vector<std::string> words(n);
+    for (size_t i = 0; i < n; ++i) words[i] = "token" + std::to_string(i);
+    std::unique_ptr<DLList> copy;
+    {
+        Arena arena;
+        DLList source;
+        for (size_t i = 0; i < n; ++i) {
+            source.emplaceBefore(i, words[i].data(), words[i].size(), static_cast<int>(i + 1), arena);
+        }
+        copy.reset(new DLList(source));
+    }
+    Arena scratch;
+    for (size_t i = 0; i < n; ++i) scratch.copyString(std::string(words[i].size(), '#').c_str(), words[i].size());
+    bool ok = copy->size() == n;
+    size_t i = 0;
+    for (const IndexedToken& entry : *copy) {
+        ok = ok && i < n && entry.getToken().isOwned() &&
+             entry.getToken().compare(words[i].data(), words[i].size()) == 0 &&
+             entry.getLineNumbers().back() == static_cast<int>(i + 1);
+        ++i;
+    }
+    if (!ok) {
+        std::cerr << "Error: A copied DLList depends on its source's arena" << std::endl;
+    }
+
+    // 200 postings: borrowed bytes beyond the inline ones, plus checkpoints
+    const std::string textFile = "bench_copy_check.txt";
+    const std::string indexFile = textFile + ".idx";
+    {
+        std::ofstream out(textFile.c_str());
+        for (int line = 1; line <= 200; ++line) out << "copied\n";
+    }
+    std::unique_ptr<IndexedToken> copied;
+    {
+        SilenceCout silence;
+        Indexer built;
+        Indexer loaded;
+        if (built.processTextFile(textFile) && built.save(indexFile) && loaded.load(indexFile)) {
+            const IndexedToken* token = loaded.find("copied");
+            if (token) copied.reset(new IndexedToken(*token));
+        }
+    }
+    std::remove(textFile.c_str());
+    std::remove(indexFile.c_str());
+    bool loadedOk = copied && copied->getLineNumbers().getSize() == 200 &&
+                    copied->getLineNumbers().bytesReserved() > 0;
+    if (loadedOk) {
+        int expected = 1;
+        for (IntList::const_iterator it = copied->getLineNumbers().begin(); it != copied->getLineNumbers().end(); ++it) {
+            loadedOk = loadedOk && *it == expected++;
+        }
+        loadedOk = loadedOk && copied->getLineNumbers().getElementAt(150) == 151;
+    }
+    if (!loadedOk) {
+        std::cerr << "Error: A copied token depends on its source's mapped index file" << std::endl;
+    }
+    json.beginObject("copies");
+    json.integer("arena_list_copy_intact", ok ? 1 : 0);
+    json.integer("loaded_token_copy_intact", loadedOk ? 1 : 0);
+    json.endObject();
+    return ok && loadedOk;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Settings settings;
+    if (!parseArgs(argc, argv, settings)) {
+        std::cerr << "Usage: indexer_bench [--size BYTES[K|M|G]] [--vocab N] [--zipf S] [--words MIN:MAX]\n"
+                  << "                     [--seed N] [--threads N] [--queries N] [--input FILE]\n"
+                  << "                     [--corpus FILE] [--keep] [--check] [--out FILE]\n";
+        return 1;
+    }
+    JsonWriter json;
+    json.integer("format_version", 1);
+    bool allocationsOk = benchAllocations(json);
+    allocationsOk = benchCopies(json) && allocationsOk;
+    if (settings.checkOnly) {
+        std::cout << json.str();
+        return allocationsOk ? 0 : 3;
+    }
+    CorpusGenerator generator(settings.corpus);
+    std::string corpus = settings.input.empty() ? settings.corpusFile : settings.input;
+
+    json.beginObject("config");
+    json.string("corpus", corpus);
+    json.integer("generated", settings.input.empty() ? 1 : 0);
+    json.integer("target_bytes", settings.corpus.bytes);
+    json.integer("vocabulary", settings.corpus.vocabulary);
+    json.number("zipf", settings.corpus.zipf);
+    json.integer("min_words_per_line", settings.corpus.minWordsPerLine);
+    json.integer("max_words_per_line", settings.corpus.maxWordsPerLine);
+    json.integer("seed", settings.corpus.seed);
+    json.integer("threads", settings.threads);
+    json.integer("hardware_threads", hardwareThreads());
+    json.string("tokenizer_kernel", Tokenizer::kernelName());
+    json.endObject();
+
+    if (settings.input.empty()) {
+        Clock::time_point start = Clock::now();
+        if (!generator.writeFile(corpus)) {
+            std::cerr << "Error: Cannot write corpus " << corpus << std::endl;
+            return 2;
+        }
+        json.number("generate_seconds", secondsSince(start));
+    }
+
+    FileReader reader;
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    if (!reader.open(corpus) || !reader.isMapped() || !reader.nextChunk(begin, end)) {
+        std::cerr << "Error: Cannot map corpus " << corpus << std::endl;
+        return 2;
+    }
+    uint64_t corpusBytes = static_cast<uint64_t>(end - begin);
+    json.integer("corpus_bytes", corpusBytes);
+
+    json.beginObject("tokenizer");
+    benchTokenizer(json, "prose", begin, end);
+    {
+        // Long CSV-style lines: no whitespace inside a line, so each line is one long token
+        CorpusGenerator::Options csv = settings.corpus;
+        csv.bytes = std::min<uint64_t>(settings.corpus.bytes, 64u << 20);
+        csv.minWordsPerLine = 256;
+        csv.maxWordsPerLine = 512;
+        csv.separator = ",";
+        std::string text = CorpusGenerator(csv).generate();
+        benchTokenizer(json, "csv_long_lines", text.data(), text.data() + text.size());
+    }
+    json.endObject();
+    reader.close();
+
+    benchIndexer(json, settings, corpus, corpusBytes, generator);
+    benchDLList(json, generator, settings.queries);
+    benchDLListOrders(json, generator);
+    benchIntList(json);
+    benchToken(json, generator);
+    json.integer("peak_rss_bytes", peakRssBytes());
+
+    if (settings.input.empty() && !settings.keep) {
+        std::remove(corpus.c_str());
+    }
+    std::string report = json.str();
+    if (settings.output.empty()) {
+        std::cout << report;
+    } else {
+        std::ofstream out(settings.output.c_str());
+        out << report;
+        if (!out) {
+            std::cerr << "Error: Cannot write " << settings.output << std::endl;
+            return 2;
+        }
+    }
+    return allocationsOk ? 0 : 3;
+}
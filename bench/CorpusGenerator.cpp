@@ -0,0 +1,144 @@
+// CorpusGenerator.cpp
+// Purpose: Implement the Zipf corpus generator.
+
+#include "CorpusGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+// Line assembly is buffered and flushed in blocks of this size
+const size_t flushBytes = 1 << 20;
+
+// Append one line of words to out, return the bytes appended
+template <typename Sample>
+size_t appendLine(std::string& out, std::mt19937_64& rng, const CorpusGenerator::Options& options,
+                  const std::vector<std::string>& words, Sample sample) {
+    size_t before = out.size();
+    std::uniform_int_distribution<size_t> count(options.minWordsPerLine, options.maxWordsPerLine);
+    size_t n = count(rng);
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) {
+            out += options.separator;
+        }
+        out += words[sample()];
+    }
+    out += '\n';
+    return out.size() - before;
+}
+
+} // namespace
+
+CorpusGenerator::Options::Options()
+    : bytes(16u << 20), vocabulary(50000), zipf(1.1), minWordsPerLine(4), maxWordsPerLine(16),
+      separator(" "), seed(1) {}
+
+CorpusGenerator::CorpusGenerator(const Options& opts) : options(opts), rng(opts.seed) {
+    if (options.vocabulary == 0) {
+        options.vocabulary = 1;
+    }
+    if (options.maxWordsPerLine < options.minWordsPerLine) {
+        options.maxWordsPerLine = options.minWordsPerLine;
+    }
+    buildVocabulary();
+    cumulative.resize(options.vocabulary);
+    double total = 0;
+    for (size_t r = 0; r < options.vocabulary; ++r) {
+        total += 1.0 / std::pow(static_cast<double>(r + 1), options.zipf);
+        cumulative[r] = total;
+    }
+}
+
+// Private helper: Distinct pseudo-words. Lengths follow a rough English shape (short words
+// are frequent), some are capitalised or carry punctuation so every section gets tokens.
+void CorpusGenerator::buildVocabulary() {
+    static const char letters[] = "etaoinshrdlcumwfgypbvkjxqz";
+    static const char* punctuation[] = { ",", ".", ";", ":", "!", "?" };
+    std::mt19937_64 wordRng(options.seed ^ 0x9E3779B97F4A7C15ULL);
+    std::geometric_distribution<int> extraLength(0.25);
+    std::uniform_int_distribution<int> letter(0, 25);
+    std::uniform_int_distribution<int> percent(0, 99);
+    words.reserve(options.vocabulary);
+    for (size_t r = 0; r < options.vocabulary; ++r) {
+        std::string w;
+        int kind = percent(wordRng);
+        if (kind < 3) {
+            // Numbers land in the non-alpha section
+            w = std::to_string(r);
+        } else {
+            size_t length = 1 + static_cast<size_t>(extraLength(wordRng)) + (r > 676 ? 2 : 0);
+            for (size_t i = 0; i < length; ++i) {
+                w += letters[letter(wordRng)];
+            }
+            // Rank suffix keeps words mostly distinct without changing the length shape much
+            if (r >= 26) {
+                w += letters[r % 26];
+            }
+            if (kind < 13) {
+                w[0] = static_cast<char>(w[0] - 'a' + 'A');
+            }
+            if (kind >= 90) {
+                w += punctuation[kind % 6];
+            }
+        }
+        words.push_back(w);
+    }
+    // Deduplicate by appending the rank where the random draw collided (base words hold no
+    // digits after a letter, so the suffixed word cannot collide again)
+    std::vector<size_t> order(words.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [this](size_t a, size_t b) { return words[a] < words[b] || (words[a] == words[b] && a < b); });
+    for (size_t i = 1; i < order.size(); ++i) {
+        if (words[order[i]] == words[order[i - 1]]) {
+            words[order[i]] += std::to_string(order[i]);
+        }
+    }
+}
+
+// Private helper: Binary search of a uniform draw in the cumulative weights
+size_t CorpusGenerator::sampleRank() {
+    std::uniform_real_distribution<double> u(0.0, cumulative.back());
+    double x = u(rng);
+    return static_cast<size_t>(std::upper_bound(cumulative.begin(), cumulative.end(), x) - cumulative.begin()) %
+           cumulative.size();
+}
+
+bool CorpusGenerator::writeFile(const std::string& filename) {
+    FILE* f = std::fopen(filename.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    std::string buffer;
+    buffer.reserve(flushBytes + 4096);
+    uint64_t written = 0;
+    bool ok = true;
+    while (ok && written < options.bytes) {
+        written += appendLine(buffer, rng, options, words, [this]() { return sampleRank(); });
+        if (buffer.size() >= flushBytes || written >= options.bytes) {
+            ok = std::fwrite(buffer.data(), 1, buffer.size(), f) == buffer.size();
+            buffer.clear();
+        }
+    }
+    return std::fclose(f) == 0 && ok;
+}
+
+std::string CorpusGenerator::generate() {
+    std::string out;
+    out.reserve(static_cast<size_t>(options.bytes) + 4096);
+    while (out.size() < options.bytes) {
+        appendLine(out, rng, options, words, [this]() { return sampleRank(); });
+    }
+    return out;
+}
+
+const std::string& CorpusGenerator::word(size_t rank) const {
+    return words[rank];
+}
+
+size_t CorpusGenerator::vocabularySize() const {
+    return words.size();
+}
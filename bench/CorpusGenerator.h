@@ -0,0 +1,52 @@
+// CorpusGenerator.h
+// Purpose: Declare the CorpusGenerator class, which writes synthetic text corpora for the
+// benchmarks. Words are drawn from a fixed pseudo-word vocabulary with Zipf-distributed
+// frequencies (rank r has weight 1 / r^s), so a few words dominate as in natural text
+// while the tail keeps the dictionary large. Output is deterministic for a given seed
+// and is streamed, so corpora from kilobytes to gigabytes use constant memory.
+
+#ifndef CORPUSGENERATOR_H
+#define CORPUSGENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+class CorpusGenerator {
+public:
+    // Generation parameters
+    struct Options {
+        uint64_t bytes;             // Target output size (stops at the first line past it)
+        size_t vocabulary;          // Distinct words
+        double zipf;                // Zipf exponent s
+        size_t minWordsPerLine;     // Words per line are uniform in [min, max]
+        size_t maxWordsPerLine;
+        const char* separator;      // Between words (" " for prose, "," for CSV-like lines)
+        uint64_t seed;
+        Options();                  // 16 MiB, 50000 words, s = 1.1, 4-16 words, " ", seed 1
+    };
+
+private:
+    Options options;
+    std::vector<std::string> words;     // Vocabulary by rank
+    std::vector<double> cumulative;     // Cumulative Zipf weights by rank
+    std::mt19937_64 rng;
+    void buildVocabulary();             // Private helper: pseudo-words with mixed first characters
+    size_t sampleRank();                // Private helper: draw a rank from the Zipf CDF
+
+public:
+    // Constructors
+    explicit CorpusGenerator(const Options& options);
+    CorpusGenerator(const CorpusGenerator& other) = delete;
+    CorpusGenerator& operator=(const CorpusGenerator& other) = delete;
+
+    // Public methods
+    bool writeFile(const std::string& filename);    // Write the corpus, false on I/O error
+    std::string generate();                         // Return the corpus as a string (small sizes)
+    const std::string& word(size_t rank) const;     // Vocabulary word by rank (0 = most frequent)
+    size_t vocabularySize() const;
+};
+
+#endif // CORPUSGENERATOR_H
@@ -1,6 +1,12 @@
 #include <iostream>
 #include "IndexerUI.h"
-int main() {
+#include "IndexerCLI.h"
+int main(int argc, char* argv[]) {
+    // Any arguments select the non-interactive command mode
+    if (argc > 1) {
+        IndexerCLI cli;
+        return cli.run(argc, argv);
+    }
     std::cout << "Starting Text File Indexer\n";
     IndexerUI indexer;
     indexer.run();